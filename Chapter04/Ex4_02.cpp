@@ -1,39 +1,69 @@
 // Ex4_02.cpp
 // Determining word frequency
 
-#include <algorithm> // For replace_if() & for_each()
-#include <cctype>    // For isalpha()
+#include <algorithm> // For sort() & max()
+#include <chrono>    // For clocks, duration, and time_point
 #include <iomanip>   // For stream manipulators
 #include <iostream>  // For standard streams
-#include <iterator>
-#include <map>     // For map container
-#include <sstream> // For istringstream
-#include <string>  // For string class
+#include <string>    // For string class, stoul()
+#include <thread>    // For thread class
+
+#include "Mapped_File.h"
+#include "Word_Count.h"
 
 using std::string;
 
-int main()
+// Output the k most frequent words in a file using n_threads threads
+void count_file(const string& file_name, size_t k, size_t n_threads)
 {
-  std::cout << "Enter some text and enter * to end:\n";
-  string text_in{};
-  std::getline(std::cin, text_in, '*');
+  auto start_time = std::chrono::steady_clock::now();
+  Mapped_File file{ file_name };
+  if (!file) {
+    std::cerr << file_name << " not open." << std::endl;
+    exit(1);
+  }
+  file.sequential();
+  auto counts = count_words(file.begin(), file.end(), n_threads);
+  auto top = counts.top(k);
+  auto end_time = std::chrono::steady_clock::now();
+  std::chrono::duration<double> elapsed{ end_time - start_time };
 
-  // Replace non-alphabetic characters by a space
-  std::replace_if(std::begin(text_in), std::end(text_in),
-                  [](const char& ch) { return !isalpha(ch); }, ' ');
+  size_t max_len{};
+  for (const auto& w : top)
+    max_len = std::max(max_len, w.first.length());
+  for (const auto& w : top)
+    std::cout << std::left << std::setw(max_len + 1) << w.first << std::right
+              << std::setw(12) << w.second << '\n';
+  std::cout << "Number of words: " << counts.words() << ", different words: "
+            << counts.size() << '\n'
+            << "Counted " << file.size() / 1048576.0 << " MB in " << elapsed.count()
+            << " seconds with " << n_threads << " threads - "
+            << file.size() / 1048576.0 / elapsed.count() << " MB/s" << std::endl;
+}
 
-  std::istringstream text(text_in);          // Text input string as a stream
-  std::istream_iterator<string> begin(text); // Stream iterator
-  std::istream_iterator<string> end;         // End stream iterator
+int main(int argc, char* argv[])
+{
+  // Ex4_02 file [k [threads]] outputs the k most frequent words in a file
+  if (argc > 1) {
+    size_t k{ argc > 2 ? std::stoul(argv[2]) : 20 };
+    size_t n_threads{ std::thread::hardware_concurrency() };
+    if (argc > 3)
+      n_threads = std::stoul(argv[3]);
+    count_file(argv[1], k, std::max(n_threads, size_t{ 1 }));
+    return 0;
+  }
 
-  std::map<string, size_t> words; // Map to store words & word counts
-  size_t max_len{};               // Maximum word length
+  std::cout << "Enter some text and enter * to end:\n";
+  string text_in{};
+  std::getline(std::cin, text_in, '*');
 
-  // Get the words, store in the map, and find maximum length
-  std::for_each(begin, end, [&max_len, &words](const string& word) {
-    words[word]++;
-    max_len = std::max(max_len, word.length());
-  });
+  // Count the words - sequences of alphabetic characters - in the text
+  auto counts = count_words(text_in.data(), text_in.data() + text_in.size());
+  auto words = counts.frequencies();
+  std::sort(std::begin(words), std::end(words)); // Alphabetical order
+  size_t max_len{};                              // Maximum word length
+  for (const auto& w : words)
+    max_len = std::max(max_len, w.first.length());
 
   size_t per_line{ 4 }, count{};
   for (const auto& w : words) {
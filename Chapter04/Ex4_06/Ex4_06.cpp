@@ -0,0 +1,259 @@
+// Ex4_06.cpp
+// Analyzing how and when the number of buckets in an unordered_map container increases
+// With --diagnose, the program reports how well a hash function and a table work for
+// a set of keys read from a file. With --latency, it plots the time for each insertion
+// into an unordered_map and into an Incremental_Map, which rehashes incrementally.
+
+#include <algorithm>     // For max_element(), sort(), unique()
+#include <cctype>        // For isdigit()
+#include <fstream>       // For file streams
+#include <iomanip>       // For stream manipulators
+#include <iostream>      // For standard streams
+#include <string>        // For string class
+#include <unordered_map> // For unordered_map container
+#include <vector>        // For vector container
+
+#include "Hash_Combiner.h"
+#include "Hash_Diagnostics.h"
+#include "Hash_Function_Objects.h" // From Ex4_07
+
+using std::string;
+using std::unordered_map;
+
+// Hash a string with a Hash_Combiner
+class FastHash {
+public:
+  size_t operator()(const string& key) const { return hash_fields(key); }
+};
+
+// Read the distinct lines of a file as keys, or make n keys like the ones below if the
+// argument is a number
+std::vector<string> read_keys(const string& source)
+{
+  std::vector<string> keys;
+  if (std::isdigit(static_cast<unsigned char>(source[0]))) {
+    size_t n{ std::stoul(source) };
+    for (size_t i{ 1 }; i <= n; ++i)
+      keys.push_back("name" + std::to_string(i));
+    return keys;
+  }
+  std::ifstream in{ source };
+  if (!in) {
+    std::cerr << source << " not open." << std::endl;
+    exit(1);
+  }
+  for (string line; std::getline(in, line);)
+    if (!line.empty())
+      keys.push_back(line);
+  std::sort(std::begin(keys), std::end(keys));
+  keys.erase(std::unique(std::begin(keys), std::end(keys)), std::end(keys));
+  return keys;
+}
+
+// Make a Name from a key - the first word and the rest of the key
+Name to_name(const string& key)
+{
+  auto space = key.find(' ');
+  auto second = key.find_first_not_of(' ', space);
+  if (second == string::npos)
+    return { key.substr(0, space), "" };
+  return { key.substr(0, space), key.substr(second) };
+}
+
+// Diagnose a table of keys for each maximum load factor - 0 is the default
+template <typename Key, typename Hash>
+void diagnose_tables(const std::vector<Key>& keys, const string& table,
+                     const string& hasher, const std::vector<float>& load_factors)
+{
+  for (auto load_factor : load_factors) {
+    Hash_Report report;
+    if (table == "flat")
+      report = diagnose<Flat_Multimap<Key, size_t, Hash>>(keys, load_factor);
+    else if (table == "incremental")
+      report = diagnose<Incremental_Map<Key, size_t, Hash>>(keys, load_factor);
+    else
+      report = diagnose<unordered_map<Key, size_t, Hash>>(keys, load_factor);
+    report.table = table;
+    report.hasher = hasher;
+    print_report(report, std::cout);
+  }
+}
+
+// Outputs number of elements in each bucket
+void list_bucket_counts(const std::vector<size_t>& counts)
+{
+  for (size_t i{}; i < counts.size(); ++i) {
+    std::cout << "bucket[" << std::setw(2) << i << "] = " << counts[i] << "  ";
+    if ((i + 1) % 6 == 0)
+      std::cout << '\n';
+  }
+  std::cout << std::endl;
+}
+
+// Plot the time for each insertion of n keys into an unordered_map and an
+// Incremental_Map, and write the times to a CSV file if a name is given
+void compare_insert_times(size_t n, const string& csv_file)
+{
+  auto keys = read_keys(std::to_string(n));
+  std::vector<Hash_Report> reports;
+  reports.push_back(diagnose<unordered_map<string, size_t, FastHash>>(keys));
+  reports.back().table = "unordered_map";
+  reports.push_back(diagnose<Incremental_Map<string, size_t, FastHash>>(keys));
+  reports.back().table = "Incremental_Map";
+  keys.clear();
+
+  for (const auto& report : reports) {
+    std::cout << '\n' << report.table << std::fixed << std::setprecision(0)
+              << "  Insert time (ns): median " << percentile(report.insert_ns, 0.5)
+              << "  99% " << percentile(report.insert_ns, 0.99) << "  99.9% "
+              << percentile(report.insert_ns, 0.999) << "  max "
+              << percentile(report.insert_ns, 1.0) << std::setprecision(2)
+              << "\nBuild time " << report.build_seconds * 1e3 << " ms  Memory "
+              << std::setprecision(1)
+              << static_cast<double>(report.memory) / report.elements
+              << " bytes per element\nLongest insert in each group of "
+              << (n + 71) / 72 << ":\n"
+              << std::defaultfloat;
+    plot_insert_times(report.insert_ns, std::cout);
+  }
+
+  if (!csv_file.empty()) {
+    std::ofstream out{ csv_file };
+    if (!out) {
+      std::cerr << csv_file << " not open." << std::endl;
+      exit(1);
+    }
+    write_insert_times(reports, out);
+  }
+}
+
+// Show how the buckets fill as elements are added and when the container is rehashed
+void show_bucket_growth()
+{
+  unordered_map<string, size_t> people;
+  float mlf{ people.max_load_factor() };     // Current maximum load factor
+  size_t n_buckets{ people.bucket_count() }; // Number of buckets in container
+
+  std::vector<size_t> bucket_counts(
+    people.bucket_count());       // Records number of elements per bucket
+  string name{ "Name" };          // Key - with value appended
+  size_t value{ 1 };              // Element value
+  size_t max_count{ 8192 };       // Maximum number of elements to insert
+  auto lf = people.load_factor(); // Current load factor
+  bool rehash{ false };           // Records when rehash occurs
+
+  while (mlf <= 1.5f) // Loop until max load factor is 1.5
+  {
+    std::cout << "\n\n***************New Container***************"
+              << "\nNumber of buckets: " << n_buckets << "  Maximum load factor: " << mlf
+              << std::endl;
+
+    // Insert max elements in container
+    for (size_t n_elements{}; n_elements < max_count; ++n_elements) {
+      lf = people.load_factor(); // Record load factor
+      people.emplace("name" + std::to_string(++value), value);
+      auto new_count = people.bucket_count(); // Current bucket count
+      if (new_count > n_buckets)              // If bucket count increases...
+      {                                       // Output info
+        std::cout << "\nBucket count increased to " << new_count << ". Load factor was "
+                  << lf << " and is now " << people.load_factor()
+                  << "\nMaximum elements in a bucket was "
+                  << *std::max_element(std::begin(bucket_counts), std::end(bucket_counts))
+                  << std::endl;
+        if (n_buckets <= 64) {
+          std::cout << "Bucket counts before increase were: " << std::endl;
+          list_bucket_counts(bucket_counts);
+        }
+        n_buckets = new_count;                          // Update bucket count
+        bucket_counts = std::vector<size_t>(n_buckets); // New vector for counts
+        rehash = true;                                  // Record rehash occurred
+      }
+
+      // Record current bucket counts
+      for (size_t i{}; i < n_buckets; ++i)
+        bucket_counts[i] = people.bucket_size(i);
+
+      if (rehash)       // If the container was rehashed...
+      {                 // ...output info
+        rehash = false; // Reset rehash indicator
+
+        std::cout << "\nRehashed container. Bucket count is " << n_buckets
+                  << ". Element count is " << people.size()
+                  << "\nMaximum element count in a bucket is now "
+                  << *std::max_element(std::begin(bucket_counts), std::end(bucket_counts))
+                  << std::endl;
+
+        if (n_buckets <= 64) // If no more than 64 buckets...
+        {
+          std::cout << "\nBucket counts after rehash are:\n";
+          list_bucket_counts(bucket_counts);
+        }
+      }
+    }
+    std::cout << "Final state for this container is:\n"
+              << "Bucket count: " << people.bucket_count()
+              << "  Element count: " << people.size()
+              << "  Maximum element count in a bucket: "
+              << *std::max_element(std::begin(bucket_counts), std::end(bucket_counts))
+              << std::endl;
+    value = 1;                                // Reset key suffix
+    people = unordered_map<string, size_t>(); // New empty container
+    n_buckets = people.bucket_count();
+    bucket_counts = std::vector<size_t>(n_buckets); // New vector for bucket counts
+    mlf += 0.25f;                                   // Increase max load factor...
+    people.max_load_factor(mlf);                    // ...and set for container
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc < 2) {
+    show_bucket_growth();
+    return 0;
+  }
+
+  // Ex4_06 --latency [n [csv_file]]
+  if (string{ argv[1] } == "--latency") {
+    compare_insert_times(argc > 2 ? std::stoul(argv[2]) : 10'000'000,
+                         argc > 3 ? argv[3] : "");
+    return 0;
+  }
+
+  // Ex4_06 --diagnose keys [std|name|fast [std|flat|incremental [max_load_factor...]]]
+  string hasher{ argc > 3 ? argv[3] : "std" };
+  string table{ argc > 4 ? argv[4] : "std" };
+  if (string{ argv[1] } != "--diagnose" || argc < 3
+      || (hasher != "std" && hasher != "name" && hasher != "fast")
+      || (table != "std" && table != "flat" && table != "incremental")) {
+    std::cerr << "Usage: Ex4_06 --diagnose keys [std|name|fast [std|flat|incremental "
+                 "[max_load_factor...]]]\n"
+                 "       Ex4_06 --latency [n [csv_file]]\n"
+                 "keys is a file with one key per line, or the number of keys "
+                 "name1, name2... to make\n"
+                 "The name hasher splits each key into a first and second name."
+              << std::endl;
+    exit(1);
+  }
+  std::vector<float> load_factors;
+  for (int arg{ 5 }; arg < argc; ++arg)
+    load_factors.push_back(std::stof(argv[arg]));
+  if (load_factors.empty())
+    load_factors.push_back(0.0f); // The default for the table
+
+  auto keys = read_keys(argv[2]);
+  std::cout << keys.size() << " distinct keys from " << argv[2] << std::endl;
+  if (hasher == "std") {
+    diagnose_tables<string, std::hash<string>>(keys, table, hasher, load_factors);
+  } else if (hasher == "fast") {
+    diagnose_tables<string, FastHash>(keys, table, hasher, load_factors);
+  } else {
+    std::vector<Name> names;
+    for (const auto& key : keys)
+      names.push_back(to_name(key));
+    keys.clear();
+    // Keys that differ only in their spaces make equal names
+    std::sort(std::begin(names), std::end(names));
+    names.erase(std::unique(std::begin(names), std::end(names)), std::end(names));
+    diagnose_tables<Name, NameHash>(names, table, hasher, load_factors);
+  }
+}
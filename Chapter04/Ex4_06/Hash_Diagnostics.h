@@ -0,0 +1,365 @@
+// Hash_Diagnostics.h for Ex4_06
+// Measures how well a hash function and a hash table work together for a set of keys
+// The keys are inserted one at a time into an empty table, timing each insertion and
+// noting when the table is rehashed. The finished table is then examined:
+// - For an unordered_map or an Incremental_Map, the length of the chain in each bucket,
+//   compared with the Poisson distribution that an ideal hash function would give.
+// - For a Flat_Multimap, the number of slots probed to find each element, and the
+//   runs of occupied slots that the probes have to step through.
+// The mean number of entries a successful and an unsuccessful lookup examine are
+// compared with the values for an ideal hash at the same load factor. Ratios well above
+// 1 show that the hash values cluster. Distinct keys with the same 64-bit hash value
+// are counted too, as no table can separate them.
+
+#ifndef HASH_DIAGNOSTICS_H
+#define HASH_DIAGNOSTICS_H
+
+#include <algorithm>     // For sort(), min(), max(), max_element(), nth_element()
+#include <chrono>        // For clocks, duration, and time_point
+#include <cmath>         // For exp(), pow()
+#include <cstddef>       // For size_t, ptrdiff_t
+#include <cstdint>       // For uint64_t
+#include <iomanip>       // For stream manipulators
+#include <ostream>       // For ostream class
+#include <string>        // For string class
+#include <unordered_map> // For unordered_map container
+#include <vector>        // For vector container
+
+#if defined(__GLIBC__)
+#include <malloc.h> // For mallinfo2()
+#endif
+
+#include "Benchmark.h" // For resident_memory()
+#include "Flat_Multimap.h"
+#include "Incremental_Map.h"
+
+// A rehash that happened during the insertion of an element
+struct Rehash_Event {
+  size_t elements{};  // Number of elements after the insertion
+  size_t old_slots{}; // Buckets or slots before...
+  size_t new_slots{}; // ...and after
+  double seconds{};   // Time for the insertion
+};
+
+struct Hash_Report {
+  std::string table;
+  std::string hasher;
+  size_t elements{};
+  size_t slots{}; // Buckets or slots
+  float max_load_factor{};
+  size_t memory{}; // Bytes allocated for the table and its elements
+  size_t hash_collisions{}; // Keys whose 64-bit hash equals that of another key
+
+  std::string length_name;     // What lengths[] counts
+  std::vector<size_t> lengths; // lengths[k] is the number with length k
+  std::vector<double> ideal;   // The same for an ideal hash - empty if not known
+  size_t longest{};            // Longest chain or run of occupied slots
+  double mean_hit{};           // Entries examined by a successful lookup...
+  double mean_miss{};          // ...and by an unsuccessful lookup
+  double ideal_hit{};          // The same for an ideal hash
+  double ideal_miss{};
+
+  std::vector<float> insert_ns; // Time for each insertion in nanoseconds
+  std::vector<Rehash_Event> rehashes;
+  double build_seconds{};
+};
+
+// Bytes of heap memory in use, or the resident memory if that is not known
+inline size_t heap_in_use()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || __GLIBC_MINOR__ >= 33)
+  auto info = mallinfo2(); // Unlike resident memory, this falls when blocks are freed
+  return info.uordblks + info.hblkhd;
+#else
+  return resident_memory();
+#endif
+}
+
+// Count the keys whose hash is the same as that of another key - keys must be distinct
+template <typename Key, typename Hash>
+size_t count_hash_collisions(const std::vector<Key>& keys, const Hash& hash)
+{
+  std::vector<uint64_t> values;
+  values.reserve(keys.size());
+  for (const auto& key : keys)
+    values.push_back(hash(key));
+  std::sort(std::begin(values), std::end(values));
+  size_t count{};
+  for (size_t i{ 1 }; i < values.size(); ++i)
+    count += values[i] == values[i - 1];
+  return count;
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+size_t slot_count(const std::unordered_map<K, T, H, E, A>& table)
+{
+  return table.bucket_count();
+}
+
+template <typename K, typename T, typename H, typename E>
+size_t slot_count(const Flat_Multimap<K, T, H, E>& table)
+{
+  return table.slot_count();
+}
+
+template <typename K, typename T, typename H, typename E>
+size_t slot_count(const Incremental_Map<K, T, H, E>& table)
+{
+  return table.bucket_count();
+}
+
+// Record the chain lengths of a table that uses chaining
+template <typename Table>
+void examine_chains(const Table& table, Hash_Report& report)
+{
+  report.length_name = "Chain length  buckets";
+  double hit_total{}, miss_total{};
+  for (size_t bucket{}; bucket < table.bucket_count(); ++bucket) {
+    size_t length{ table.bucket_size(bucket) };
+    if (length >= report.lengths.size())
+      report.lengths.resize(length + 1);
+    ++report.lengths[length];
+    hit_total += length * (length + 1) / 2.0; // The kth element takes k comparisons
+    miss_total += length;
+    report.longest = std::max(report.longest, length);
+  }
+  double m{ static_cast<double>(table.bucket_count()) };
+  double n{ static_cast<double>(table.size()) };
+  report.mean_hit = n > 0 ? hit_total / n : 0.0;
+  report.mean_miss = miss_total / m;
+  report.ideal_hit = 1.0 + (n - 1) / (2.0 * m);
+  report.ideal_miss = n / m;
+
+  // Ideally the number of elements in a bucket has a Poisson distribution
+  double probability{ std::exp(-n / m) };
+  for (size_t k{}; k < report.lengths.size(); ++k) {
+    report.ideal.push_back(m * probability);
+    probability *= n / m / (k + 1);
+  }
+}
+
+template <typename K, typename T, typename H, typename E, typename A>
+void examine_table(const std::unordered_map<K, T, H, E, A>& table, Hash_Report& report)
+{
+  examine_chains(table, report);
+}
+
+// The old buckets are emptied first, so all the chains are in the new buckets
+template <typename K, typename T, typename H, typename E>
+void examine_table(Incremental_Map<K, T, H, E>& table, Hash_Report& report)
+{
+  table.finish_rehash();
+  examine_chains(table, report);
+}
+
+// Record the probe lengths of a table that uses linear probing
+template <typename K, typename T, typename H, typename E>
+void examine_table(const Flat_Multimap<K, T, H, E>& table, Hash_Report& report)
+{
+  report.length_name = "Probe length elements";
+  report.lengths.resize(1);
+  double hit_total{};
+  for (auto iter = table.begin(); iter != table.end(); ++iter) {
+    size_t length{ table.probe_length(iter) };
+    if (length >= report.lengths.size())
+      report.lengths.resize(length + 1);
+    ++report.lengths[length];
+    hit_total += length;
+  }
+
+  // A lookup that fails examines the slots from its home slot to the end of the run of
+  // occupied slots, and the empty slot after it
+  size_t slots{ table.slot_count() };
+  size_t start{};
+  while (!table.slot_empty(start)) // There is always an empty slot
+    ++start;
+  double miss_total{};
+  size_t run{};
+  for (size_t i{ 1 }; i <= slots; ++i) {
+    if (table.slot_empty((start + i) % slots)) {
+      miss_total += run * (run + 1) / 2.0 + run + 1;
+      report.longest = std::max(report.longest, run);
+      run = 0;
+    } else {
+      ++run;
+    }
+  }
+  double n{ static_cast<double>(table.size()) };
+  double load{ n / slots };
+  report.mean_hit = n > 0 ? hit_total / n : 0.0;
+  report.mean_miss = miss_total / slots;
+  report.ideal_hit = 0.5 * (1.0 + 1.0 / (1.0 - load)); // Knuth's results
+  report.ideal_miss = 0.5 * (1.0 + 1.0 / ((1.0 - load) * (1.0 - load)));
+}
+
+// Insert distinct keys into an empty table and examine the result
+// A max_load_factor of 0 leaves the default for the table.
+template <typename Table>
+Hash_Report diagnose(const std::vector<typename Table::key_type>& keys,
+                     float max_load_factor = 0.0f)
+{
+  using Clock = std::chrono::steady_clock;
+  Hash_Report report;
+  report.insert_ns.reserve(keys.size());
+  size_t memory_before{ heap_in_use() };
+  {
+    Table table;
+    if (max_load_factor > 0.0f)
+      table.max_load_factor(max_load_factor);
+    report.max_load_factor = table.max_load_factor();
+
+    size_t slots{ slot_count(table) };
+    auto build_start = Clock::now();
+    for (size_t i{}; i < keys.size(); ++i) {
+      auto start = Clock::now();
+      table.emplace(keys[i], i);
+      std::chrono::duration<double> elapsed{ Clock::now() - start };
+      report.insert_ns.push_back(static_cast<float>(elapsed.count() * 1e9));
+      if (slot_count(table) != slots) {
+        report.rehashes.push_back({ i + 1, slots, slot_count(table), elapsed.count() });
+        slots = slot_count(table);
+      }
+    }
+    report.build_seconds = std::chrono::duration<double>{ Clock::now() - build_start }
+                             .count();
+    report.memory = heap_in_use() - memory_before;
+    report.elements = table.size();
+    report.slots = slots;
+    report.hash_collisions = count_hash_collisions(keys, table.hash_function());
+    examine_table(table, report);
+  }
+  return report;
+}
+
+// The value below which a fraction of the values lie
+inline float percentile(std::vector<float> values, double fraction)
+{
+  if (values.empty())
+    return 0.0f;
+  auto position = static_cast<std::ptrdiff_t>(fraction * (values.size() - 1));
+  auto nth = std::begin(values) + position;
+  std::nth_element(std::begin(values), nth, std::end(values));
+  return *nth;
+}
+
+inline void print_report(const Hash_Report& report, std::ostream& out)
+{
+  const size_t max_rows{ 16 }; // Longer lengths are added together
+  out << std::fixed << std::setprecision(3) << "\nTable: " << report.table
+      << "  Hasher: " << report.hasher << "  Maximum load factor: "
+      << report.max_load_factor << "\nElements: " << report.elements
+      << "  Slots: " << report.slots << "  Load factor: "
+      << static_cast<double>(report.elements) / report.slots << std::setprecision(1)
+      << "  Memory per element: "
+      << static_cast<double>(report.memory) / std::max<size_t>(report.elements, 1)
+      << " bytes\nKeys with the same 64-bit hash as another key: "
+      << report.hash_collisions << "\n\n";
+
+  out << std::setprecision(3)
+      << "Entries examined by a lookup     actual     ideal   ratio\n"
+      << "  successful                 " << std::setw(10) << report.mean_hit
+      << std::setw(10) << report.ideal_hit << std::setw(8)
+      << report.mean_hit / report.ideal_hit << "\n  unsuccessful               "
+      << std::setw(10) << report.mean_miss << std::setw(10) << report.ideal_miss
+      << std::setw(8) << report.mean_miss / std::max(report.ideal_miss, 1e-9)
+      << "\nLongest " << (report.ideal.empty() ? "run of occupied slots: " : "chain: ")
+      << report.longest << "\n\n";
+
+  out << report.length_name << "   percent" << (report.ideal.empty() ? "" : "     ideal")
+      << '\n';
+  size_t total{};
+  for (auto count : report.lengths)
+    total += count;
+  for (size_t k{}; k < report.lengths.size() && k <= max_rows; ++k) {
+    size_t count{ report.lengths[k] };
+    double ideal{ k < report.ideal.size() ? report.ideal[k] : 0.0 };
+    if (k == max_rows) { // Add up the rest
+      for (size_t j{ k + 1 }; j < report.lengths.size(); ++j) {
+        count += report.lengths[j];
+        ideal += j < report.ideal.size() ? report.ideal[j] : 0.0;
+      }
+    }
+    if (count == 0 && ideal < 0.5)
+      continue;
+    std::string label{ (k == max_rows ? ">=" : "") + std::to_string(k) };
+    out << std::setw(12) << label << std::setw(10) << count << std::setprecision(2)
+        << std::setw(10) << 100.0 * count / std::max<size_t>(total, 1);
+    if (!report.ideal.empty())
+      out << std::setprecision(0) << std::setw(10) << ideal;
+    out << '\n';
+  }
+
+  double rehash_seconds{};
+  for (const auto& rehash : report.rehashes)
+    rehash_seconds += rehash.seconds;
+  out << std::setprecision(0) << "\nInsert time (ns)  median "
+      << percentile(report.insert_ns, 0.5) << "  99% "
+      << percentile(report.insert_ns, 0.99) << "  99.9% "
+      << percentile(report.insert_ns, 0.999) << "  max "
+      << percentile(report.insert_ns, 1.0) << std::setprecision(2) << "\nBuild time "
+      << report.build_seconds * 1e3 << " ms, of which " << report.rehashes.size()
+      << " rehashes took " << rehash_seconds * 1e3 << " ms ("
+      << 100.0 * rehash_seconds / std::max(report.build_seconds, 1e-9) << "%)\n";
+  if (!report.rehashes.empty())
+    out << "  elements  slots before   slots after  insert time (us)\n";
+  for (const auto& rehash : report.rehashes)
+    out << std::setw(10) << rehash.elements << std::setw(14) << rehash.old_slots
+        << std::setw(14) << rehash.new_slots << std::setw(18) << rehash.seconds * 1e6
+        << '\n';
+  out << std::defaultfloat << std::flush;
+}
+
+// Plot the longest insert time in each of width groups of consecutive insertions, on a
+// log scale with two rows for each factor of 10 from 100 ns up to the longest time
+inline void plot_insert_times(const std::vector<float>& insert_ns, std::ostream& out,
+                              size_t width = 72)
+{
+  if (insert_ns.empty())
+    return;
+  width = std::min(width, insert_ns.size());
+  std::vector<float> longest(width);
+  for (size_t i{}; i < insert_ns.size(); ++i) {
+    auto& group_longest = longest[i * width / insert_ns.size()];
+    group_longest = std::max(group_longest, insert_ns[i]);
+  }
+
+  const char* labels[]{ "100 ns", "1 us", "10 us", "100 us", "1 ms", "10 ms", "100 ms",
+                        "1 s",    "10 s" };
+  int top{};
+  for (auto ns : longest)
+    while (top < 16 && ns >= 100.0 * std::pow(10.0, (top + 1) / 2.0))
+      ++top;
+  for (int row{ top }; row >= 0; --row) {
+    double level{ 100.0 * std::pow(10.0, row / 2.0) };
+    out << std::setw(7) << (row % 2 == 0 ? labels[row / 2] : "") << " |";
+    for (auto ns : longest)
+      out << (ns >= level ? '#' : ' ');
+    out << '\n';
+  }
+  out << "        +" << std::string(width, '-') << "\n         0" << std::setw(width - 1)
+      << insert_ns.size() << " inserts" << std::endl;
+}
+
+// Write the longest insert time in each group of consecutive insertions as CSV, with
+// a column for each report
+inline void write_insert_times(const std::vector<Hash_Report>& reports, std::ostream& out,
+                               size_t rows = 10'000)
+{
+  size_t n{ reports.empty() ? 0 : reports[0].insert_ns.size() };
+  rows = std::min(rows, n);
+  out << "insert";
+  for (const auto& report : reports)
+    out << ',' << report.table << "_ns";
+  out << '\n';
+  for (size_t row{}; row < rows; ++row) {
+    size_t first{ row * n / rows }, last{ (row + 1) * n / rows };
+    out << first;
+    for (const auto& report : reports) {
+      auto begin = std::begin(report.insert_ns);
+      out << ',' << *std::max_element(begin + static_cast<std::ptrdiff_t>(first),
+                                      begin + static_cast<std::ptrdiff_t>(last));
+    }
+    out << '\n';
+  }
+}
+#endif
@@ -1,12 +1,22 @@
 // Ex4_07.cpp
+// A phone book stored in two flat hash multimaps, one keyed by name and one by number
 
-#include <cctype>        // For toupper()
+#include <cctype>        // For toupper(), isdigit()
+#include <chrono>        // For clocks, duration, and time_point
+#include <iomanip>       // For stream manipulators
 #include <iostream>      // For standard streams
-#include <string>        // For string class
+#include <iterator>      // For distance()
+#include <limits>        // For numeric_limits
+#include <random>        // For random number generator
+#include <string>        // For string class, to_string()
 #include <unordered_map> // For unordered_map container
+#include <vector>        // For vector container
 
+#include "Benchmark.h"
+#include "Flat_Multimap.h"
 #include "Hash_Function_Objects.h"
 #include "My_Templates.h"
+#include "Packed_Phone.h"
 #include "Record_IO.h"
 
 using std::string;
@@ -14,6 +24,162 @@ using std::unordered_multimap;
 using Name = std::pair<string, string>;
 using Phone = std::tuple<string, string, string>;
 
+// Make name k from syllables - names are up to 9 characters so no string allocates
+Name make_name(size_t k)
+{
+  static const string syllables[]{ "ba", "ko", "ri", "ten", "mo", "sha", "lu", "de",
+                                   "vin", "ra", "po", "gi", "el", "an", "tor", "mi" };
+  auto word = [](size_t n) {
+    string text;
+    for (size_t i{}; i < 3; ++i, n /= 16)
+      text += syllables[n % 16];
+    text[0] = static_cast<char>(std::toupper(text[0]));
+    return text;
+  };
+  return { word(k % 4096), word(k / 4096) };
+}
+
+// Make a unique phone number for record i
+Phone make_phone(size_t i)
+{
+  return { std::to_string(200 + i % 800), std::to_string(100 + i / 800 % 900),
+           std::to_string(1000 + i / 720000) };
+}
+
+PackedPhone make_packed_phone(size_t i)
+{
+  auto phone = make_phone(i);
+  return { std::get<0>(phone), std::get<1>(phone), std::get<2>(phone) };
+}
+
+// Build a map of n records, where make_record(i) returns the key and value of record i,
+// and time looking up keys in it
+template <typename Map, typename Make_Record>
+void measure_phone_book(const string& type, size_t n, Make_Record make_record,
+                        const std::vector<typename Map::key_type>& queries,
+                        const Benchmark_Options& options)
+{
+  auto memory_before = resident_memory();
+  auto start_time = std::chrono::steady_clock::now();
+  Map map{ n };
+  for (size_t i{}; i < n; ++i) {
+    auto record = make_record(i);
+    map.emplace(std::move(record.first), std::move(record.second));
+  }
+  auto end_time = std::chrono::steady_clock::now();
+  std::chrono::duration<double> build_time{ end_time - start_time };
+  auto memory = resident_memory() - memory_before;
+
+  Benchmark_Suite suite{ "Ex4_07 " + type };
+  size_t found{};
+  suite.add(type + " equal_range", [&] {
+    found = 0;
+    for (const auto& key : queries) {
+      auto range = map.equal_range(key);
+      found += static_cast<size_t>(std::distance(range.first, range.second));
+    }
+    do_not_optimize(found);
+  });
+  auto results = suite.run(options);
+  std::cout << std::left << std::setw(30) << type << std::right << std::fixed
+            << std::setprecision(2) << std::setw(10) << build_time.count()
+            << std::setprecision(0) << std::setw(12) << memory / 1048576.0
+            << std::setprecision(1) << std::setw(14)
+            << results[0].median * 1e9 / queries.size() << std::setw(12) << found
+            << std::defaultfloat << std::endl;
+}
+
+// Output the column headings for the results of measure_phone_book()
+void show_headings(const string& title)
+{
+  std::cout << '\n'
+            << title << '\n'
+            << std::left << std::setw(30) << "container" << std::right << std::setw(10)
+            << "build (s)" << std::setw(12) << "memory (MB)" << std::setw(14)
+            << "lookup (ns)" << std::setw(12) << "found" << std::endl;
+}
+
+// Compare the flat multimap with unordered_multimap for a phone book of n records keyed
+// by name, and a packed phone number key with a tuple of strings for one keyed by number
+// Every name is shared by two records on average.
+void benchmark(size_t n, const Benchmark_Options& options)
+{
+  const size_t n_queries{ 100'000 };
+  std::vector<Name> names;
+  std::vector<Phone> numbers;
+  std::vector<PackedPhone> packed_numbers;
+  std::mt19937_64 rng{ 7u };
+  for (size_t i{}; i < n_queries; ++i) {
+    names.push_back(make_name(rng() % (n / 2 + 1)));
+    numbers.push_back(make_phone(rng() % n));
+    packed_numbers.push_back({ std::get<0>(numbers.back()), std::get<1>(numbers.back()),
+                               std::get<2>(numbers.back()) });
+  }
+
+  auto name_record = [rng = std::mt19937_64{ 42u }, n](size_t i) mutable {
+    return std::make_pair(make_name(rng() % (n / 2 + 1)), make_phone(i));
+  };
+  // The flat maps are measured first, as their large blocks are returned to the system
+  // when they are destroyed, while the memory for the nodes of the other may not be
+  show_headings(std::to_string(n) + " records, " + std::to_string(n_queries)
+                + " random lookups by number");
+  measure_phone_book<Flat_Multimap<PackedPhone, Name, PackedPhoneHash>>(
+    "Flat_Multimap<PackedPhone>", n,
+    [](size_t i) { return std::make_pair(make_packed_phone(i), make_name(i)); },
+    packed_numbers, options);
+  measure_phone_book<Flat_Multimap<Phone, Name, PhoneHash>>(
+    "Flat_Multimap<Phone>", n,
+    [](size_t i) { return std::make_pair(make_phone(i), make_name(i)); }, numbers,
+    options);
+
+  show_headings(std::to_string(n) + " records, " + std::to_string(n_queries)
+                + " random lookups by name");
+  measure_phone_book<Flat_Multimap<Name, Phone, NameHash>>("Flat_Multimap", n,
+                                                          name_record, names, options);
+  measure_phone_book<unordered_multimap<Name, Phone, NameHash>>(
+    "unordered_multimap", n, name_record, names, options);
+}
+
+// Time hashing keys with the hash function objects and with the concatenating hash
+// functions they replace, which allocate when the concatenated key is long
+void hash_benchmark(const Benchmark_Options& options)
+{
+  const size_t n{ 100'000 };
+  std::vector<Name> names;
+  std::vector<Phone> phones;
+  std::mt19937_64 rng{ 7u };
+  for (size_t i{}; i < n; ++i) {
+    names.push_back(make_name(rng() % (1 << 24)));
+    phones.push_back(make_phone(rng() % 10'000'000));
+  }
+
+  Benchmark_Suite suite{ "Ex4_07 hash" };
+  size_t sum{};
+  auto add_kernel = [&](const string& name, const auto& keys, auto hash) {
+    suite.add(name, [&keys, &sum, hash] {
+      for (const auto& key : keys)
+        sum += hash(key);
+      do_not_optimize(sum);
+    });
+  };
+  add_kernel("NameHash", names, NameHash());
+  add_kernel("Name concatenated", names, [](const Name& name) {
+    return std::hash<string>()(name.first + name.second);
+  });
+  add_kernel("PhoneHash", phones, PhoneHash());
+  add_kernel("Phone concatenated", phones, [](const Phone& phone) {
+    return std::hash<string>()(std::get<0>(phone) + std::get<1>(phone)
+                               + std::get<2>(phone));
+  });
+  auto results = suite.run_and_report(options);
+
+  std::cout << "\nTime per key for " << n << " keys\n";
+  for (const auto& result : results)
+    std::cout << std::left << std::setw(22) << result.name << std::right << std::fixed
+              << std::setprecision(1) << std::setw(8) << result.median * 1e9 / n << " ns"
+              << std::defaultfloat << std::endl;
+}
+
 // Display command prompt
 void show_operations()
 {
@@ -25,27 +191,65 @@ void show_operations()
             << "Q: Quit the program.\n\n";
 }
 
-int main()
+int main(int argc, char* argv[])
 {
-  unordered_multimap<Name, Phone, NameHash> by_name{ 8, NameHash() };
-  unordered_multimap<Phone, Name, PhoneHash> by_number{ 8, PhoneHash() };
+  // Ex4_07 --benchmark [n] [options] compares containers for a phone book of n records
+  if (argc > 1 && string{ argv[1] } == "--benchmark") {
+    size_t n{ 10'000'000 };
+    int arg{ 2 };
+    if (arg < argc && std::isdigit(static_cast<unsigned char>(argv[arg][0])))
+      n = std::stoul(argv[arg++]);
+    Benchmark_Options options;
+    options.samples = 10;
+    if (!parse_benchmark_options(argc, argv, arg, options)) {
+      std::cerr << "Usage: Ex4_07 --benchmark [n] [--samples N] [--warmup N] "
+                   "[--max-seconds S] [--no-pin]"
+                << std::endl;
+      exit(1);
+    }
+    benchmark(n, options);
+    return 0;
+  }
+
+  // Ex4_07 --hash-benchmark [options] times the hash function objects
+  if (argc > 1 && string{ argv[1] } == "--hash-benchmark") {
+    Benchmark_Options options;
+    if (!parse_benchmark_options(argc, argv, 2, options)) {
+      std::cerr << "Usage: Ex4_07 --hash-benchmark [--samples N] [--warmup N] "
+                   "[--max-seconds S] [--no-pin]"
+                << std::endl;
+      exit(1);
+    }
+    hash_benchmark(options);
+    return 0;
+  }
+
+  Flat_Multimap<Name, PackedPhone, NameHash> by_name{ 8, NameHash() };
+  Flat_Multimap<PackedPhone, Name, PackedPhoneHash> by_number{ 8, PackedPhoneHash() };
   show_operations();
 
-  char choice{};  // Operation selection
-  Phone number{}; // Records a number
-  Name name{};    // Records a name
+  char choice{};        // Operation selection
+  PackedPhone number{}; // Records a number
+  Name name{};          // Records a name
 
   while (std::toupper(choice) != 'Q') // Go until you quit...
   {
+    if (std::cin.fail() && !std::cin.eof()) { // A number was not valid
+      std::cout << "Phone numbers must be digits, " << PackedPhone::max_digits
+                << " at most.\n";
+      std::cin.clear();
+      std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    }
     std::cout << "Enter a command: ";
     std::cin >> choice;
     switch (std::toupper(choice)) {
     case 'A': // Add a record
       std::cout << "Enter first & second names, area code, exchange, and number "
                    "separated by spaces:\n";
-      std::cin >> name >> number;
-      by_name.emplace(name, number);   // Create in place...
-      by_number.emplace(number, name); // ...in both containers
+      if (std::cin >> name >> number) {
+        by_name.emplace(name, number);   // Create in place...
+        by_number.emplace(number, name); // ...in both containers
+      }
       break;
     case 'D': // Delete records
     {
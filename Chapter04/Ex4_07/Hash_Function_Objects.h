@@ -1,13 +1,19 @@
 // Hash_Function_Objects.h
 // Hash function object types for Ex4_07
+// The members of each key are fed to a Hash_Combiner in turn, so hashing a key
+// allocates nothing. A packed phone number is hashed with a single multiply.
 
 #ifndef HASH_FUNCTION_OBJECTS_H
 #define HASH_FUNCTION_OBJECTS_H
 
+#include <cstdint> // For uint64_t
 #include <string>  // For string class
 #include <tuple>   // For tuple type
 #include <utility> // For pair type
 
+#include "Hash_Combiner.h"
+#include "Packed_Phone.h"
+
 using Name = std::pair<std::string, std::string>;
 using Phone = std::tuple<std::string, std::string, std::string>;
 
@@ -16,8 +22,19 @@ class PhoneHash {
 public:
   size_t operator()(const Phone& phone) const
   {
-    return std::hash<std::string>()(std::get<0>(phone) + std::get<1>(phone)
-                                    + std::get<2>(phone));
+    return hash_fields(std::get<0>(phone), std::get<1>(phone), std::get<2>(phone));
+  }
+};
+
+// Hash a packed phone number by multiplying it by 2^64 divided by the golden ratio
+// The high bits of the product depend on all the bits of the number, so they are
+// rotated to the low end, which a hash table uses to pick a bucket.
+class PackedPhoneHash {
+public:
+  size_t operator()(const PackedPhone& phone) const
+  {
+    uint64_t product{ phone.value() * 0x9E3779B97F4A7C15ULL };
+    return static_cast<size_t>(product >> 32 | product << 32);
   }
 };
 
@@ -26,7 +43,7 @@ class NameHash {
 public:
   size_t operator()(const Name& name) const
   {
-    return std::hash<std::string>()(name.first + name.second);
+    return hash_fields(name.first, name.second);
   }
 };
-#endif
\ No newline at end of file
+#endif
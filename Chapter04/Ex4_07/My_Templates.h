@@ -2,6 +2,8 @@
 
 #include <iostream>
 
+#include "Record_IO.h" // The templates use the operators for Name and Phone
+
 // List all elements
 template <typename Container>
 void list_elements(const Container& container)
@@ -0,0 +1,83 @@
+// Packed_Phone.h for Ex4_07
+// A phone number stored as one 64-bit integer instead of a tuple of three strings
+// Each digit takes 4 bits, and 4 bits with the value 15 separate the area code, the
+// exchange, and the number, so the parts can have any lengths up to 14 digits in total.
+// The first digit is in the most significant bits that are used. A digit d is stored
+// as d + 1, so the leading bits that are 0 are never confused with a digit and a value
+// of 0 means no number. Comparing and hashing a number are each a single operation.
+
+#ifndef PACKED_PHONE_H
+#define PACKED_PHONE_H
+
+#include <cstdint>     // For uint64_t
+#include <string>      // For string class
+#include <string_view> // For string_view
+
+class PackedPhone {
+private:
+  uint64_t code{}; // 0 is not a number
+
+  static const uint64_t separator{ 15 };
+
+  // Append 4 bits - returns false if there is no room
+  bool append(uint64_t nibble)
+  {
+    if (code >> 60 != 0)
+      return false;
+    code = code << 4 | nibble;
+    return true;
+  }
+
+  // Append the digits in text - returns false if it has a character that is not a digit
+  // or there is no room
+  bool append(std::string_view text)
+  {
+    for (char ch : text)
+      if (ch < '0' || ch > '9' || !append(static_cast<uint64_t>(ch - '0' + 1)))
+        return false;
+    return true;
+  }
+
+public:
+  static const size_t max_digits{ 14 };
+  static const size_t max_length{ max_digits + 2 }; // Characters in the text form
+
+  PackedPhone() = default;
+
+  // Pack the area code, exchange, and number - the result is not valid() if there are
+  // characters that are not digits or more than max_digits digits
+  PackedPhone(std::string_view area_code, std::string_view exchange,
+              std::string_view number)
+  {
+    if (!(append(area_code) && append(separator) && append(exchange) && append(separator)
+          && append(number)))
+      code = 0;
+  }
+
+  bool valid() const { return code != 0; }
+  uint64_t value() const { return code; }
+
+  // Write the parts separated by spaces starting at first, which must have room for
+  // max_length characters - returns a pointer to the character after the last one
+  char* to_chars(char* first) const
+  {
+    int shift{ 60 };
+    while (shift >= 0 && (code >> shift & 15) == 0) // Skip the unused bits
+      shift -= 4;
+    for (; shift >= 0; shift -= 4) {
+      auto nibble = code >> shift & 15;
+      *first++ = nibble == separator ? ' ' : static_cast<char>('0' + nibble - 1);
+    }
+    return first;
+  }
+
+  std::string to_string() const
+  {
+    char text[max_length];
+    return std::string(text, to_chars(text));
+  }
+
+  bool operator==(const PackedPhone& phone) const { return code == phone.code; }
+  bool operator!=(const PackedPhone& phone) const { return code != phone.code; }
+};
+#endif
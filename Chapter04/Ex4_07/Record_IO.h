@@ -7,6 +7,8 @@
 #include <tuple>   // For tuple type
 #include <utility> // For pair type
 
+#include "Packed_Phone.h"
+
 using Name = std::pair<std::string, std::string>;
 using Phone = std::tuple<std::string, std::string, std::string>;
 
@@ -19,6 +21,14 @@ inline std::ostream& operator<<(std::ostream& out, const Phone& phone)
   return out;
 }
 
+// Packed phone number output - the same text as for Phone
+inline std::ostream& operator<<(std::ostream& out, const PackedPhone& phone)
+{
+  char text[PackedPhone::max_length];
+  out.write(text, phone.to_chars(text) - text);
+  return out;
+}
+
 // Name output
 inline std::ostream& operator<<(std::ostream& out, const Name& name)
 {
@@ -35,6 +45,18 @@ inline std::istream& operator>>(std::istream& in, Phone& phone)
   return in;
 }
 
+// Packed phone number input - fails if a part is not all digits or there are too many
+inline std::istream& operator>>(std::istream& in, PackedPhone& phone)
+{
+  std::string area_code{}, exchange{}, number{};
+  if (in >> std::ws >> area_code >> exchange >> number) {
+    phone = PackedPhone{ area_code, exchange, number };
+    if (!phone.valid())
+      in.setstate(std::ios_base::failbit);
+  }
+  return in;
+}
+
 // Name input
 inline std::istream& operator>>(std::istream& in, Name& name)
 {
@@ -1,15 +1,13 @@
 // Ex5_04.cpp
 // Determining word frequency
 
-#include <algorithm> // For replace_if() & for_each()
-#include <cctype>    // For isalpha()
+#include <algorithm> // For sort() & max()
 #include <iomanip>   // For stream manipulators
 #include <iostream>  // For standard streams
-#include <iterator>  // For advance()
-#include <set>       // For map container
-#include <sstream>   // For istringstream
 #include <string>    // For string class
 
+#include "Word_Count.h"
+
 using std::string;
 
 int main()
@@ -18,30 +16,21 @@ int main()
   string text_in{};
   std::getline(std::cin, text_in, '*');
 
-  // Replace non-alphabetic characters by a space
-  std::replace_if(std::begin(text_in), std::end(text_in),
-                  [](const char& ch) { return !isalpha(ch); }, ' ');
-
-  std::istringstream text(text_in);          // Text input string as a stream
-  std::istream_iterator<string> begin(text); // Stream iterator
-  std::istream_iterator<string> end;         // End stream iterator
-
-  std::multiset<string> words; // Container to store words
-  size_t max_len{};            // Maximum word length
-
-  // Get the words, store in the container, and find maximum length
-  std::for_each(begin, end, [&max_len, &words](const string& word) {
-    words.emplace(word);
-    max_len = std::max(max_len, word.length());
-  });
+  // Count the words - sequences of alphabetic characters - in the text
+  // Each word is a string_view referring to text_in, so no word is copied.
+  auto counts = count_words(text_in.data(), text_in.data() + text_in.size());
+  auto words = counts.frequencies();
+  std::sort(std::begin(words), std::end(words)); // Alphabetical order
+  size_t max_len{};                              // Maximum word length
+  for (const auto& w : words)
+    max_len = std::max(max_len, w.first.length());
 
   size_t per_line{ 4 }, // Outputs per line
     count{};            // No. of words output
 
-  for (auto iter = std::begin(words); iter != std::end(words);
-       iter = words.upper_bound(*iter)) {
-    std::cout << std::left << std::setw(max_len + 1) << *iter << std::setw(3)
-              << std::right << words.count(*iter) << "  ";
+  for (const auto& w : words) {
+    std::cout << std::left << std::setw(max_len + 1) << w.first << std::setw(3)
+              << std::right << w.second << "  ";
     if (++count % per_line == 0)
       std::cout << std::endl;
   }
@@ -8,6 +8,8 @@
 #include <ostream> // For output streams
 #include <string>  // For string class
 
+#include "Hash_Combiner.h"
+
 using std::string;
 
 class Name {
@@ -49,9 +51,10 @@ public:
     return (second == name.second) && (first == name.first);
   }
 
+  // Hash the two names in place - nothing is allocated
   size_t hash() const
   {
-    return std::hash<std::string>()(first + second);
+    return hash_fields(first, second);
   }
 
   friend std::istream& operator>>(std::istream& in, Name& name);
@@ -0,0 +1,130 @@
+// Ex9_03.cpp
+// Finding anagrams of a word
+
+#include <algorithm>   // For max()
+#include <chrono>      // For clocks, duration, and time_point
+#include <functional>  // For function
+#include <iostream>    // For standard streams
+#include <iterator>    // For iterators and begin() and end()
+#include <optional>    // For optional type
+#include <string>      // For string class, stoul()
+#include <string_view> // For string_view
+#include <thread>      // For hardware_concurrency()
+#include <vector>      // For vector container
+
+#include "Anagram_Index.h"
+#include "Benchmark.h"
+#include "Dictionary_Index.h"
+#include "Mapped_Dictionary.h"
+
+using std::string;
+using namespace std::chrono;
+
+int main(int argc, char* argv[])
+{
+  auto start_time = steady_clock::now();
+  string file_in{ "dictionary.txt" };
+  string index_file{ "dictionary.idx" };
+  string option{ argc > 1 ? argv[1] : "" };
+
+  // Ex9_03 --build-index [text [index]] compiles the dictionary into an index file
+  if (option == "--build-index") {
+    if (argc > 2)
+      file_in = argv[2];
+    if (argc > 3)
+      index_file = argv[3];
+    Mapped_Dictionary dictionary{ file_in };
+    if (!dictionary) {
+      std::cerr << file_in << " not open." << std::endl;
+      exit(1);
+    }
+    if (!write_dictionary_index(dictionary, file_in, index_file)) {
+      std::cerr << index_file << " not written." << std::endl;
+      exit(1);
+    }
+    duration<double> elapsed{ steady_clock::now() - start_time };
+    std::cout << "Indexed " << dictionary.size() << " words in " << index_file << " in "
+              << elapsed.count() << " seconds." << std::endl;
+    return 0;
+  }
+
+  // Ex9_03 --groups [threads] lists every group of anagrams in the dictionary
+  bool list_groups{ option == "--groups" };
+  size_t n_threads{ 1 };
+  if (list_groups)
+    n_threads = argc > 2 ? std::stoul(argv[2])
+                         : std::max(1u, std::thread::hardware_concurrency());
+
+  // Use the prebuilt index if it is current - nothing has to be read or built
+  std::function<std::vector<std::string_view>(std::string_view)> find_anagrams;
+  Dictionary_Index index{ index_file, file_in };
+  std::optional<Mapped_Dictionary> words_in;
+  std::optional<Anagram_Index> dictionary;
+  if (index && !list_groups) {
+    find_anagrams = [&index](std::string_view word) { return index.anagrams(word); };
+    duration<double> elapsed{ steady_clock::now() - start_time };
+    std::cout << "Mapped index of " << index.size() << " words in " << elapsed.count()
+              << " seconds." << std::endl;
+  } else {
+    // Map the file into memory and divide it into words
+    words_in.emplace(file_in);
+    if (!*words_in) {
+      std::cerr << file_in << " not open." << std::endl;
+      exit(1);
+    }
+    duration<double> elapsed{ steady_clock::now() - start_time };
+    std::cout << "Loaded " << words_in->size() << " words in " << elapsed.count()
+              << " seconds. Resident memory " << resident_memory() / 1024 << " KB."
+              << std::endl;
+
+    // Index the words by signature so the anagrams of any word are one lookup away
+    auto index_start = steady_clock::now();
+    dictionary.emplace(*words_in, n_threads);
+    elapsed = steady_clock::now() - index_start;
+    std::cout << dictionary->words() << " words in dictionary with "
+              << dictionary->signatures() << " signatures, indexed in "
+              << elapsed.count() << " seconds using " << n_threads << " threads."
+              << std::endl;
+    find_anagrams = [&dictionary](std::string_view word) {
+      return dictionary->find(word);
+    };
+  }
+
+  if (list_groups) {
+    auto groups = dictionary->anagram_groups();
+    for (auto group : groups) {
+      std::copy(std::begin(*group), std::end(*group),
+                std::ostream_iterator<std::string_view>{ std::cout, " " });
+      std::cout << '\n';
+    }
+    std::cout << groups.size() << " groups of anagrams." << std::endl;
+    return 0;
+  }
+
+  // Ex9_03 --find word... outputs the anagrams of each word and the time from starting
+  if (option == "--find") {
+    for (int i{ 2 }; i < argc; ++i) {
+      auto words = find_anagrams(argv[i]);
+      std::copy(std::begin(words), std::end(words),
+                std::ostream_iterator<std::string_view>{ std::cout, " " });
+      std::cout << '\n';
+    }
+    duration<double> elapsed{ steady_clock::now() - start_time };
+    std::cout << "Time from start to answer: " << elapsed.count() * 1000 << " ms"
+              << std::endl;
+    return 0;
+  }
+
+  // -----------------------------------------------------------------------
+
+  string word;
+  while (true) {
+    std::cout << "\nEnter a word, or Ctrl+D to end:\n";
+    if ((std::cin >> word).eof())
+      break;
+    auto words = find_anagrams(word);
+    std::copy(std::begin(words), std::end(words),
+              std::ostream_iterator<std::string_view>{ std::cout, " " });
+    std::cout << std::endl;
+  }
+}
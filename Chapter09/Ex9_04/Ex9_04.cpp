@@ -0,0 +1,84 @@
+// Ex9_04.cpp
+// Finding anagrams of a word by re-reading the dictionary file
+// The file is read once for each word, checking every word in the file against the
+// letters of the word, rather than once for every permutation of the word. If the
+// prebuilt dictionary index is current, the sorted letters of each word are looked up
+// in that instead, which finds all its anagrams at once.
+
+#include <algorithm> // For copy()
+#include <iostream>  // For standard streams
+#include <iterator>  // For iterators and begin() and end()
+#include <string>    // For string class
+#include <vector>    // For vector container
+
+#include "Dictionary_Index.h"
+#include "Pattern_Set.h"
+#include "Prefetch_Streambuf.h"
+
+using std::string;
+
+// Find the anagrams of all the words in one pass through the file
+std::vector<std::vector<string>> find_anagrams(std::istream& in,
+                                               const std::vector<string>& words)
+{
+  Pattern_Set<Sorted_Letters> patterns;
+  for (const auto& word : words)
+    patterns.add(word);
+
+  std::vector<std::vector<string>> anagrams(words.size());
+  in.clear();  // Reset EOF
+  in.seekg(0); // File position at beginning
+  patterns.scan(in, [&anagrams](size_t i, const string& word) {
+    anagrams[i].push_back(word);
+  });
+  return anagrams;
+}
+
+// Find the anagrams of a word with one lookup of its sorted letters in the index
+std::vector<string> find_anagrams(const Dictionary_Index& index, const string& word)
+{
+  auto found = index.anagrams(word);
+  return { std::begin(found), std::end(found) };
+}
+
+int main(int argc, char* argv[])
+{
+  string file_in{ "dictionary.txt" };
+  Dictionary_Index index{ "dictionary.idx", file_in }; // Mapped index - if it is current
+  Prefetch_Istream in; // Reads the file ahead while the words are matched
+  if (!index)
+    in.open(file_in);
+  if (!index && !in) {
+    std::cerr << file_in << " not open." << std::endl;
+    exit(1);
+  }
+
+  // Ex9_04 word... finds the anagrams of the words with one pass through the file
+  if (argc > 1) {
+    std::vector<string> words{ argv + 1, argv + argc };
+    std::vector<std::vector<string>> anagrams;
+    if (index)
+      for (const auto& word : words)
+        anagrams.push_back(find_anagrams(index, word));
+    else
+      anagrams = find_anagrams(in, words);
+    for (const auto& found : anagrams) {
+      std::copy(std::begin(found), std::end(found),
+                std::ostream_iterator<string>{ std::cout, " " });
+      std::cout << std::endl;
+    }
+    return 0;
+  }
+
+  string word;
+  while (true) {
+    std::cout << "\nEnter a word, or Ctrl+D to end: ";
+    if ((std::cin >> word).eof())
+      break;
+    auto words = index ? find_anagrams(index, word) : find_anagrams(in, { word })[0];
+    std::copy(std::begin(words), std::end(words),
+              std::ostream_iterator<string>{ std::cout, " " });
+    std::cout << std::endl;
+  }
+  in.close(); // Close the file
+}
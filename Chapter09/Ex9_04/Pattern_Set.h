@@ -0,0 +1,84 @@
+// Pattern_Set.h for Ex9_04
+// Matches the words in a stream against any number of patterns in a single pass
+// Each pattern is stored in a hash table under a key computed by a function object, and
+// each word read from the stream is matched by computing its key and looking it up, so
+// the cost per word does not depend on the number of patterns. Words with a length no
+// pattern has are skipped without computing a key. With the default key a word matches
+// a pattern that is the same word; with Sorted_Letters a word matches every pattern that
+// is an anagram of it. Only the patterns are held in memory, never the stream contents.
+
+#ifndef PATTERN_SET_H
+#define PATTERN_SET_H
+
+#include <algorithm>     // For sort()
+#include <cctype>        // For tolower()
+#include <istream>       // For istream class
+#include <string>        // For string class
+#include <unordered_map> // For unordered_map container
+#include <vector>        // For vector container
+
+// Key for matching words exactly
+struct Same_Word {
+  const std::string& operator()(const std::string& word) const { return word; }
+};
+
+// Key for matching anagrams - the letters of the word in lowercase and in sorted order,
+// the same as the signature the dictionary index uses, so case does not matter
+struct Sorted_Letters {
+  std::string operator()(std::string word) const
+  {
+    for (auto& ch : word)
+      ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+    std::sort(std::begin(word), std::end(word));
+    return word;
+  }
+};
+
+template <typename Key = Same_Word>
+class Pattern_Set {
+private:
+  Key key;
+  std::vector<std::string> patterns;
+  std::unordered_map<std::string, std::vector<size_t>> index; // Key to pattern indexes
+  std::vector<bool> lengths;                                  // true for pattern lengths
+
+public:
+  explicit Pattern_Set(Key k = Key{})
+    : key(k)
+  {
+  }
+
+  // Add a pattern and return its index
+  size_t add(const std::string& pattern)
+  {
+    patterns.push_back(pattern);
+    index[key(pattern)].push_back(patterns.size() - 1);
+    if (lengths.size() <= pattern.size())
+      lengths.resize(pattern.size() + 1);
+    lengths[pattern.size()] = true;
+    return patterns.size() - 1;
+  }
+
+  size_t size() const { return patterns.size(); }
+  const std::string& operator[](size_t i) const { return patterns[i]; }
+
+  // Read words from the stream until the end, calling found(i, word) for each word that
+  // matches pattern i. Returns the number of words read.
+  template <typename Found>
+  size_t scan(std::istream& in, Found found) const
+  {
+    size_t count{};
+    std::string word;
+    while (in >> word) {
+      ++count;
+      if (word.size() >= lengths.size() || !lengths[word.size()])
+        continue;
+      auto iter = index.find(key(word));
+      if (iter != std::end(index))
+        for (auto i : iter->second)
+          found(i, word);
+    }
+    return count;
+  }
+};
+#endif
@@ -1,17 +1,109 @@
 // Ex9_05.cpp
 // Copying file contents using stream iterators
+// The input stream reads the file ahead on a background thread, so reading the file
+// overlaps extracting the words.
 
-#include <fstream>  // For file streams
-#include <iostream> // For standard streams
-#include <iterator> // For iterators and begin() and end()
-#include <string>   // For string class
+#include <algorithm> // For copy()
+#include <cctype>    // For isdigit()
+#include <cstdio>    // For remove()
+#include <fstream>   // For file streams
+#include <iostream>  // For standard streams
+#include <iterator>  // For iterators and begin() and end()
+#include <string>    // For string class, stoul()
+
+#include "Benchmark.h"
+#include "Prefetch_Streambuf.h"
+
+#if defined(__linux__)
+#include <fcntl.h>  // For open(), posix_fadvise()
+#include <unistd.h> // For fdatasync(), close()
+#endif
 
 using std::string;
 
-int main()
+// Remove a file from the page cache so the next read comes from the disk
+void drop_cache(const string& file_name)
+{
+#if defined(__linux__)
+  int fd{ ::open(file_name.c_str(), O_RDONLY) };
+  if (fd < 0)
+    return;
+  ::fdatasync(fd);
+  ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  ::close(fd);
+#else
+  (void)file_name;
+#endif
+}
+
+// Count the words in a stream with stream iterators
+size_t count_words(std::istream& in)
+{
+  return std::distance(std::istream_iterator<string>{ in },
+                       std::istream_iterator<string>{});
+}
+
+// Time counting the words in a file of megabytes MB that is not in the page cache, with
+// an ifstream and with prefetching streams of several block sizes
+void benchmark(size_t megabytes, const string& dictionary, Benchmark_Options options)
+{
+  string file_name{ "prefetch_test.txt" };
+  {
+    std::ifstream in{ dictionary, std::ios_base::in | std::ios_base::binary };
+    string words{ std::istreambuf_iterator<char>{ in },
+                  std::istreambuf_iterator<char>{} };
+    if (words.empty()) {
+      std::cerr << dictionary << " not open." << std::endl;
+      exit(1);
+    }
+    std::ofstream out{ file_name, std::ios_base::out | std::ios_base::trunc };
+    for (size_t size{}; size < (megabytes << 20); size += words.size())
+      out << words;
+  }
+
+  options.pin_thread = false; // The reader thread must be free to run on another core
+  Benchmark_Suite suite{ "Ex9_05 cold cache word count" };
+  auto cold = [&file_name] { drop_cache(file_name); };
+  suite.add("ifstream", cold, [&file_name] {
+    std::ifstream in{ file_name };
+    do_not_optimize(count_words(in));
+  });
+  for (size_t block_size : { 64 << 10, 1 << 20, 4 << 20 })
+    suite.add("prefetch " + std::to_string(block_size >> 10) + " KB", cold,
+              [&file_name, block_size] {
+                Prefetch_Istream in{ file_name, block_size };
+                do_not_optimize(count_words(in));
+              });
+  std::cout << "Counting the words in " << megabytes << " MB:\n";
+  suite.run_and_report(options);
+  std::remove(file_name.c_str());
+}
+
+int main(int argc, char* argv[])
 {
   string file_in{ "dictionary.txt" };
-  std::ifstream in{ file_in };
+
+  // Ex9_05 --benchmark [MB] [options] times reading a file that is not cached
+  if (argc > 1 && string{ argv[1] } == "--benchmark") {
+    size_t megabytes{ 256 };
+    int arg{ 2 };
+    if (arg < argc && std::isdigit(static_cast<unsigned char>(argv[arg][0])))
+      megabytes = std::stoul(argv[arg++]);
+    Benchmark_Options options;
+    options.samples = 5;
+    options.warmup_iterations = 0;
+    options.warmup_seconds = 0;
+    if (!parse_benchmark_options(argc, argv, arg, options)) {
+      std::cerr << "Usage: Ex9_05 --benchmark [MB] [--samples N] [--warmup N] "
+                   "[--max-seconds S] [--filter TEXT] [--json FILE]"
+                << std::endl;
+      exit(1);
+    }
+    benchmark(megabytes, file_in, options);
+    return 0;
+  }
+
+  Prefetch_Istream in{ file_in };
   if (!in) {
     std::cerr << file_in << " not open." << std::endl;
     exit(1);
@@ -0,0 +1,56 @@
+// Ex9_06.cpp
+// Counting word frequencies by first letter in a single pass of the file
+
+#include <iomanip>  // For stream manipulators
+#include <iostream> // For standard streams
+#include <string>   // For string class, stoul()
+#include <thread>   // For thread class
+
+#include "Mapped_File.h"
+#include "Word_Histogram.h"
+
+using std::string;
+
+int main(int argc, char* argv[])
+{
+  // Ex9_06 [first|last|length [threads]] selects the key that words are counted by
+  string key_name{ argc > 1 ? argv[1] : "first" };
+  size_t n_threads{ std::thread::hardware_concurrency() };
+  if (argc > 2)
+    n_threads = std::stoul(argv[2]);
+  string file_in{ "dictionary.txt" };
+  Mapped_File in{ file_in };
+  if (!in) {
+    std::cerr << file_in << " not open." << std::endl;
+    exit(1);
+  }
+  in.sequential();
+
+  size_t perline(9);
+  if (key_name == "length") {
+    size_t max_length{ 32 };
+    auto counts = word_histogram(in.begin(), in.end(), max_length + 1, Word_Length{},
+                                 n_threads);
+    for (size_t length{ 1 }, shown{}; length <= max_length; ++length) {
+      if (!counts[length])
+        continue;
+      std::cout << std::setw(2) << length << ": " << std::setw(5) << counts[length]
+                << ((++shown % perline) ? " | " : "\n");
+    }
+  } else if (key_name == "first" || key_name == "last") {
+    size_t n_letters{ 26 };
+    auto counts = key_name == "first"
+                    ? word_histogram(in.begin(), in.end(), n_letters, First_Letter{},
+                                     n_threads)
+                    : word_histogram(in.begin(), in.end(), n_letters, Last_Letter{},
+                                     n_threads);
+    string letters{ "abcdefghijklmnopqrstuvwxyz" };
+    for (auto ch : letters)
+      std::cout << ch << ": " << std::setw(5) << counts[ch - 'a']
+                << (((ch - 'a' + 1) % perline) ? " | " : "\n");
+  } else {
+    std::cerr << "Usage: Ex9_06 [first|last|length [threads]]" << std::endl;
+    exit(1);
+  }
+  std::cout << std::endl;
+}
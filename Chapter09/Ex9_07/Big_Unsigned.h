@@ -0,0 +1,262 @@
+// Big_Unsigned.h for Ex9_07
+// An unsigned integer with any number of digits
+// The value is stored as a vector of limbs in base 10^9, least significant first, so
+// converting to and from decimal text takes time proportional to the number of digits
+// and needs no long division. Multiplication uses the Karatsuba algorithm, which splits
+// each operand in two halves and forms the product from three products of the halves
+// rather than four, so the time for n digits grows as n^1.585 instead of n^2. Operands
+// below a threshold size are multiplied by the schoolbook method, accumulating the
+// products in 64 bits and propagating carries only every few rows.
+
+#ifndef BIG_UNSIGNED_H
+#define BIG_UNSIGNED_H
+
+#include <algorithm>   // For max(), min(), lexicographical_compare()
+#include <cstdint>     // For fixed width integer types
+#include <istream>     // For istream class
+#include <ostream>     // For ostream class
+#include <string>      // For string class
+#include <string_view> // For string_view
+#include <vector>      // For vector container
+
+class Big_Unsigned {
+public:
+  using Limb = uint32_t;
+  static const Limb base{ 1'000'000'000 }; // Each limb holds 9 decimal digits
+  static const size_t base_digits{ 9 };
+
+private:
+  std::vector<Limb> limbs; // Least significant first with no leading zeros - 0 is empty
+
+  static const size_t karatsuba_threshold{ 32 }; // Limbs below which schoolbook is used
+  static const size_t carry_interval{ 16 };      // Rows of products between carries
+
+  void trim()
+  {
+    while (!limbs.empty() && limbs.back() == 0)
+      limbs.pop_back();
+  }
+
+  // Add x shifted left by shift limbs to r
+  static void add_shifted(std::vector<Limb>& r, const std::vector<Limb>& x, size_t shift)
+  {
+    if (r.size() < x.size() + shift)
+      r.resize(x.size() + shift);
+    Limb carry{};
+    size_t i{};
+    for (; i < x.size(); ++i) {
+      Limb sum{ r[i + shift] + x[i] + carry };
+      carry = sum >= base;
+      r[i + shift] = carry ? sum - base : sum;
+    }
+    for (i += shift; carry; ++i) {
+      if (i == r.size())
+        r.push_back(0);
+      carry = ++r[i] == base;
+      if (carry)
+        r[i] = 0;
+    }
+  }
+
+  // Subtract x from r - r must not be less than x
+  static void subtract(std::vector<Limb>& r, const std::vector<Limb>& x)
+  {
+    Limb borrow{};
+    size_t i{};
+    for (; i < x.size(); ++i) {
+      Limb subtrahend{ x[i] + borrow };
+      borrow = r[i] < subtrahend;
+      r[i] = borrow ? r[i] + base - subtrahend : r[i] - subtrahend;
+    }
+    for (; borrow; ++i) {
+      borrow = r[i] == 0;
+      r[i] = borrow ? base - 1 : r[i] - 1;
+    }
+  }
+
+  // Schoolbook product of a[0..na) and b[0..nb)
+  static std::vector<Limb> multiply_schoolbook(const Limb* a, size_t na, const Limb* b,
+                                               size_t nb)
+  {
+    std::vector<uint64_t> sums(na + nb); // Each product is less than 10^18...
+    for (size_t i{}; i < na; ++i) {
+      uint64_t ai{ a[i] };
+      for (size_t j{}; j < nb; ++j)
+        sums[i + j] += ai * b[j];
+      if ((i + 1) % carry_interval == 0) // ...so 16 rows of them fit in 64 bits
+        carry_sums(sums);
+    }
+    carry_sums(sums);
+    return std::vector<Limb>(std::begin(sums), std::end(sums));
+  }
+
+  // Reduce every sum to less than base, carrying the excess into the next sum
+  static void carry_sums(std::vector<uint64_t>& sums)
+  {
+    uint64_t carry{};
+    for (auto& sum : sums) {
+      sum += carry;
+      carry = sum / base;
+      sum %= base;
+    }
+  }
+
+  // Karatsuba product of a[0..na) and b[0..nb) - the result may have leading zeros
+  static std::vector<Limb> multiply(const Limb* a, size_t na, const Limb* b, size_t nb)
+  {
+    if (na == 0 || nb == 0)
+      return {};
+    if (std::min(na, nb) < karatsuba_threshold)
+      return multiply_schoolbook(a, na, b, nb);
+
+    // a = a1*B^m + a0 and b = b1*B^m + b0, where B is the base
+    size_t m{ std::max(na, nb) / 2 };
+    if (std::min(na, nb) <= m) { // Unbalanced - split only the longer operand
+      if (na < nb)
+        return multiply(b, nb, a, na);
+      auto product = multiply(a, m, b, nb);
+      add_shifted(product, multiply(a + m, na - m, b, nb), m);
+      return product;
+    }
+    auto z0 = multiply(a, m, b, m);                  // a0*b0
+    auto z2 = multiply(a + m, na - m, b + m, nb - m); // a1*b1
+    std::vector<Limb> a_sum(a, a + m), b_sum(b, b + m);
+    add_shifted(a_sum, std::vector<Limb>(a + m, a + na), 0);
+    add_shifted(b_sum, std::vector<Limb>(b + m, b + nb), 0);
+    auto z1 = multiply(a_sum.data(), a_sum.size(), b_sum.data(), b_sum.size());
+    subtract(z1, z0); // (a0 + a1)*(b0 + b1) - a0*b0 - a1*b1 = a0*b1 + a1*b0
+    subtract(z1, z2);
+
+    auto& product = z0;
+    product.reserve(na + nb);
+    add_shifted(product, z1, m);
+    add_shifted(product, z2, 2 * m);
+    return product;
+  }
+
+public:
+  Big_Unsigned(uint64_t n = 0)
+  {
+    for (; n; n /= base)
+      limbs.push_back(static_cast<Limb>(n % base));
+  }
+
+  // Create from a string that contains only decimal digits
+  explicit Big_Unsigned(std::string_view digits)
+  {
+    for (size_t end{ digits.size() }; end > 0;) {
+      size_t start{ end > base_digits ? end - base_digits : 0 };
+      Limb limb{};
+      for (size_t i{ start }; i < end; ++i)
+        limb = limb * 10 + static_cast<Limb>(digits[i] - '0');
+      limbs.push_back(limb);
+      end = start;
+    }
+    trim();
+  }
+
+  bool is_zero() const { return limbs.empty(); }
+
+  // Number of decimal digits
+  size_t digits() const
+  {
+    if (limbs.empty())
+      return 1;
+    size_t count{ (limbs.size() - 1) * base_digits };
+    for (Limb top{ limbs.back() }; top; top /= 10)
+      ++count;
+    return count;
+  }
+
+  // Write the decimal digits starting at first, which must have room for digits()
+  // characters - returns a pointer to the character after the last digit
+  char* to_chars(char* first) const
+  {
+    if (limbs.empty()) {
+      *first = '0';
+      return first + 1;
+    }
+    char* last{ first + digits() };
+    char* next{ last };
+    for (size_t i{}; i + 1 < limbs.size(); ++i) // Every limb but the top has 9 digits
+      for (size_t j{}, limb{ limbs[i] }; j < base_digits; ++j, limb /= 10)
+        *--next = static_cast<char>('0' + limb % 10);
+    for (Limb top{ limbs.back() }; top; top /= 10)
+      *--next = static_cast<char>('0' + top % 10);
+    return last;
+  }
+
+  std::string to_string() const
+  {
+    std::string text(digits(), '0');
+    to_chars(&text[0]);
+    return text;
+  }
+
+  Big_Unsigned& operator+=(const Big_Unsigned& x)
+  {
+    add_shifted(limbs, x.limbs, 0);
+    return *this;
+  }
+
+  // Subtract x, which must not be greater than this value
+  Big_Unsigned& operator-=(const Big_Unsigned& x)
+  {
+    subtract(limbs, x.limbs);
+    trim();
+    return *this;
+  }
+
+  Big_Unsigned& operator*=(const Big_Unsigned& x)
+  {
+    limbs = multiply(limbs.data(), limbs.size(), x.limbs.data(), x.limbs.size());
+    trim();
+    return *this;
+  }
+
+  friend Big_Unsigned operator+(Big_Unsigned a, const Big_Unsigned& b) { return a += b; }
+  friend Big_Unsigned operator-(Big_Unsigned a, const Big_Unsigned& b) { return a -= b; }
+  friend Big_Unsigned operator*(const Big_Unsigned& a, const Big_Unsigned& b)
+  {
+    Big_Unsigned product;
+    const auto &x = a.limbs, &y = b.limbs;
+    product.limbs = multiply(x.data(), x.size(), y.data(), y.size());
+    product.trim();
+    return product;
+  }
+
+  friend bool operator==(const Big_Unsigned& a, const Big_Unsigned& b)
+  {
+    return a.limbs == b.limbs;
+  }
+  friend bool operator!=(const Big_Unsigned& a, const Big_Unsigned& b)
+  {
+    return !(a == b);
+  }
+  friend bool operator<(const Big_Unsigned& a, const Big_Unsigned& b)
+  {
+    if (a.limbs.size() != b.limbs.size())
+      return a.limbs.size() < b.limbs.size();
+    return std::lexicographical_compare(a.limbs.rbegin(), a.limbs.rend(),
+                                        b.limbs.rbegin(), b.limbs.rend());
+  }
+
+  friend std::ostream& operator<<(std::ostream& out, const Big_Unsigned& n)
+  {
+    return out << n.to_string();
+  }
+
+  // Read a sequence of decimal digits
+  friend std::istream& operator>>(std::istream& in, Big_Unsigned& n)
+  {
+    std::string digits;
+    if (in >> digits) {
+      if (digits.find_first_not_of("0123456789") == std::string::npos)
+        n = Big_Unsigned{ std::string_view{ digits } };
+      else
+        in.setstate(std::ios_base::failbit);
+    }
+    return in;
+  }
+};
+#endif
@@ -0,0 +1,109 @@
+// Buffered_Writer.h for Ex9_07
+// Writes large numbers to a file through a large buffer
+// Each number is converted to digits directly in the buffer, with no intermediate
+// string, and the buffer is written to the file when it is full, so a file of many
+// numbers is written in a few large writes. A number too large for the buffer is
+// written straight from a string. An output iterator is provided for use with
+// algorithms such as generate_n().
+
+#ifndef BUFFERED_WRITER_H
+#define BUFFERED_WRITER_H
+
+#include <cstddef>  // For size_t, ptrdiff_t
+#include <fstream>  // For file streams
+#include <iterator> // For output_iterator_tag
+#include <string>   // For string class
+#include <vector>   // For vector container
+
+#include "Big_Unsigned.h"
+
+class Buffered_Writer {
+private:
+  std::ofstream out;
+  std::vector<char> buffer;
+  size_t used{};
+  size_t bytes{}; // Total bytes written
+
+  void flush()
+  {
+    out.write(buffer.data(), static_cast<std::streamsize>(used));
+    bytes += used;
+    used = 0;
+  }
+
+public:
+  // Output iterator that writes each number assigned through it followed by a separator
+  class iterator {
+  private:
+    Buffered_Writer* writer;
+    char separator;
+
+  public:
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+
+    iterator(Buffered_Writer& w, char sep)
+      : writer(&w)
+      , separator(sep)
+    {
+    }
+    iterator& operator=(const Big_Unsigned& n)
+    {
+      writer->write(n, separator);
+      return *this;
+    }
+    iterator& operator*() { return *this; }
+    iterator& operator++() { return *this; }
+    iterator& operator++(int) { return *this; }
+  };
+
+  explicit Buffered_Writer(const std::string& file_name, size_t capacity = 1 << 22)
+    : out(file_name, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary)
+    , buffer(capacity)
+  {
+  }
+
+  ~Buffered_Writer()
+  {
+    if (out.is_open())
+      close();
+  }
+
+  Buffered_Writer(const Buffered_Writer&) = delete;
+  Buffered_Writer& operator=(const Buffered_Writer&) = delete;
+
+  explicit operator bool() const { return static_cast<bool>(out); }
+
+  // Write a number followed by a separator
+  void write(const Big_Unsigned& n, char separator)
+  {
+    size_t length{ n.digits() + 1 };
+    if (length > buffer.size() - used)
+      flush();
+    if (length > buffer.size()) {
+      auto text = n.to_string() + separator;
+      out.write(text.data(), static_cast<std::streamsize>(text.size()));
+      bytes += text.size();
+      return;
+    }
+    char* last{ n.to_chars(buffer.data() + used) };
+    *last = separator;
+    used += length;
+  }
+
+  iterator inserter(char separator = '\n') { return iterator{ *this, separator }; }
+
+  size_t size() const { return bytes + used; }
+
+  // Write the buffer contents and close the file - returns false if writing failed
+  bool close()
+  {
+    flush();
+    out.close();
+    return static_cast<bool>(out);
+  }
+};
+#endif
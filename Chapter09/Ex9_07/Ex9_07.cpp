@@ -0,0 +1,101 @@
+// Ex9_07.cpp
+// Using stream iterators to write Fibonacci numbers to a file
+
+#include <algorithm> // For generate_n() and for_each()
+#include <chrono>    // For clocks, duration, and time_point
+#include <fstream>   // For fstream
+#include <iomanip>   // For stream manipulators
+#include <iostream>  // For standard streams
+#include <iterator>  // For iterators and begin() and end()
+#include <string>    // For string class, stoull()
+
+#include "Big_Unsigned.h"
+#include "Buffered_Writer.h"
+#include "Fibonacci.h"
+
+using std::string;
+using Clock = std::chrono::steady_clock;
+
+// Output F(n) in full, or its number of digits and the first and last digits
+void nth_term(uint64_t n, bool show_all)
+{
+  auto start_time = Clock::now();
+  auto f = fibonacci(n);
+  std::chrono::duration<double> compute_time{ Clock::now() - start_time };
+  auto digits = f.to_string();
+  std::chrono::duration<double> total_time{ Clock::now() - start_time };
+
+  std::cout << "F(" << n << ") has " << digits.size() << " digits";
+  if (show_all || digits.size() <= 60)
+    std::cout << ":\n" << digits << '\n';
+  else
+    std::cout << ": " << digits.substr(0, 25) << "..."
+              << digits.substr(digits.size() - 25) << '\n';
+  std::cout << "Computed in " << compute_time.count() << " seconds, "
+            << total_time.count() << " seconds with conversion to decimal" << std::endl;
+}
+
+// Write count terms starting with F(first) to a file, one per line
+void write_terms(uint64_t first, size_t count, const string& file_name)
+{
+  auto start_time = Clock::now();
+  Buffered_Writer writer{ file_name };
+  if (!writer) {
+    std::cerr << file_name << " not open." << std::endl;
+    exit(1);
+  }
+  std::generate_n(writer.inserter(), count, Fibonacci_Generator{ first });
+  if (!writer.close()) {
+    std::cerr << file_name << " not written." << std::endl;
+    exit(1);
+  }
+  std::chrono::duration<double> elapsed{ Clock::now() - start_time };
+  std::cout << "Wrote " << count << " terms from F(" << first << ") to " << file_name
+            << " - " << writer.size() << " bytes in " << elapsed.count() << " seconds"
+            << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+  // Ex9_07 --nth n [all] outputs F(n)
+  if (argc > 2 && string{ argv[1] } == "--nth") {
+    nth_term(std::stoull(argv[2]), argc > 3 && string{ argv[3] } == "all");
+    return 0;
+  }
+  // Ex9_07 --terms first count file writes count terms from F(first) to file
+  if (argc > 1 && string{ argv[1] } == "--terms") {
+    if (argc < 5) {
+      std::cerr << "Usage: Ex9_07 --terms first count file" << std::endl;
+      exit(1);
+    }
+    write_terms(std::stoull(argv[2]), std::stoul(argv[3]), argv[4]);
+    return 0;
+  }
+
+  string file_name{ "fibonacci.txt" };
+  std::fstream fibonacci{ file_name,
+                          std::ios_base::in | std::ios_base::out | std::ios_base::trunc };
+  if (!fibonacci) {
+    std::cerr << file_name << " not open." << std::endl;
+    exit(1);
+  }
+
+  // Big_Unsigned values do not overflow, so the number of terms is not limited by the
+  // type - the generator starts with the first two values, 0 and 1.
+  auto iter = std::ostream_iterator<Big_Unsigned>{ fibonacci, " " };
+  const size_t n{ 52 };
+  std::generate_n(iter, n + 2, Fibonacci_Generator{});
+
+  // seekg() (seek for Getting data) is called to set the file back to the beginning,
+  // ready to be read. You would use seekp() (seek for Putting data) to reset the file
+  // position to write it.
+  fibonacci.seekg(0); // Back to file beginning
+  std::for_each(std::istream_iterator<Big_Unsigned>{ fibonacci },
+                std::istream_iterator<Big_Unsigned>{}, [](const Big_Unsigned& k) {
+                  const size_t perline{ 6 };
+                  static size_t count{};
+                  std::cout << std::setw(12) << k << ((++count % perline) ? " " : "\n");
+                });
+
+  fibonacci.close(); // Close the file
+}
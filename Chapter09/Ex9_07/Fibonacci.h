@@ -0,0 +1,61 @@
+// Fibonacci.h for Ex9_07
+// Computes Fibonacci numbers of any size
+// fibonacci() uses fast doubling: from F(k) and F(k+1) it obtains
+//   F(2k) = F(k) * (2*F(k+1) - F(k))    and    F(2k+1) = F(k)^2 + F(k+1)^2
+// so F(n) takes one step for each bit of n, and the cost is dominated by the
+// multiplications in the last few steps. Fibonacci_Generator produces successive terms
+// by addition, starting from any term, for use with generate_n().
+
+#ifndef FIBONACCI_H
+#define FIBONACCI_H
+
+#include <cstdint> // For uint64_t
+#include <tuple>   // For tie()
+#include <utility> // For pair, move()
+
+#include "Big_Unsigned.h"
+
+// Return F(n) and F(n+1)
+inline std::pair<Big_Unsigned, Big_Unsigned> fibonacci_pair(uint64_t n)
+{
+  Big_Unsigned a{ 0 }, b{ 1 }; // F(k) and F(k+1) for k = the bits of n used so far
+  uint64_t bit{ 1 };
+  while (bit <= n / 2)
+    bit *= 2;
+  for (; bit && n; bit /= 2) {
+    auto f_2k = a * (b + b - a);
+    auto f_2k1 = a * a + b * b;
+    if (n & bit) {
+      a = std::move(f_2k1);
+      b = f_2k + a;
+    } else {
+      a = std::move(f_2k);
+      b = std::move(f_2k1);
+    }
+  }
+  return { a, b };
+}
+
+inline Big_Unsigned fibonacci(uint64_t n) { return fibonacci_pair(n).first; }
+
+// Function object that returns F(n), F(n+1), F(n+2)... on successive calls
+class Fibonacci_Generator {
+private:
+  Big_Unsigned first{ 0 }, second{ 1 };
+
+public:
+  explicit Fibonacci_Generator(uint64_t n = 0)
+  {
+    if (n)
+      std::tie(first, second) = fibonacci_pair(n);
+  }
+
+  Big_Unsigned operator()()
+  {
+    Big_Unsigned result{ std::move(first) };
+    first = second;
+    second += result;
+    return result;
+  }
+};
+#endif
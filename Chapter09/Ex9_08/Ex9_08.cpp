@@ -0,0 +1,149 @@
+// Ex9_08.cpp
+// Using stream iterators to create a file of random temperatures
+// The temperatures are written to a binary sample file through an output iterator, read
+// back by mapping the file, and exported as text.
+
+#include <algorithm> // For generate_n() and for_each()
+#include <cctype>    // For isdigit()
+#include <cstdio>    // For remove()
+#include <fstream>   // For file streams
+#include <iomanip>   // For stream manipulators
+#include <iostream>  // For standard streams
+#include <iterator>  // For iterators and begin() and end()
+#include <numeric>   // For accumulate()
+#include <random>    // For distributions and random number generator
+#include <string>    // For string class
+
+#include "Benchmark.h"
+#include "Sample_File.h"
+
+using std::string;
+
+// Write n temperatures from a normal distribution to a sample file
+bool generate_temperatures(const string& file_name, size_t n, uint64_t seed)
+{
+  double mu{ 50.0 }, sigma{ 15.0 };               // Mean: 50 degrees SD: 15
+  std::mt19937 rng(seed);                         // Mersenne twister generator
+  std::normal_distribution<> normal{ mu, sigma }; // Create distribution
+  Sample_Writer temps_out{ file_name, seed, mu, sigma };
+  if (!temps_out)
+    return false;
+
+  // Although you can use output iterators with generate_n(), you can't use them with the
+  // generate() algorithm because it requires forward iterators.
+  std::generate_n(temps_out.inserter(), n, [&rng, &normal] { return normal(rng); });
+  return temps_out.close();
+}
+
+Sample_File open_samples(const string& file_name)
+{
+  Sample_File samples{ file_name };
+  if (!samples) {
+    std::cerr << file_name << " not open." << std::endl;
+    exit(1);
+  }
+  return samples;
+}
+
+// Compare writing and reading n temperatures as text and as a binary sample file
+void benchmark(size_t n, const Benchmark_Options& options)
+{
+  string text_file{ "temperatures_bench.txt" }, data_file{ "temperatures_bench.dat" };
+  std::vector<double> temperatures(n);
+  std::mt19937 rng{ 42u };
+  std::normal_distribution<> normal{ 50.0, 15.0 };
+  std::generate_n(std::begin(temperatures), n, [&rng, &normal] { return normal(rng); });
+
+  Benchmark_Suite suite{ "Ex9_08 temperature files" };
+  suite.add("text write", [&] {
+    std::ofstream out{ text_file, std::ios_base::out | std::ios_base::trunc };
+    std::copy(std::begin(temperatures), std::end(temperatures),
+              std::ostream_iterator<double>{ out, " " });
+  });
+  suite.add("text read", [&] {
+    std::ifstream in{ text_file };
+    do_not_optimize(std::accumulate(std::istream_iterator<double>{ in },
+                                    std::istream_iterator<double>{}, 0.0));
+  });
+  suite.add("binary write", [&] {
+    Sample_Writer out{ data_file, 42u, 50.0, 15.0 };
+    std::copy(std::begin(temperatures), std::end(temperatures), out.inserter());
+  });
+  suite.add("binary read", [&] {
+    auto samples = open_samples(data_file);
+    auto values = samples.values();
+    do_not_optimize(std::accumulate(std::begin(values), std::end(values), 0.0));
+  });
+  suite.add("to_chars export", [&] {
+    std::ofstream out{ text_file, std::ios_base::out | std::ios_base::trunc };
+    write_text(out, open_samples(data_file).values());
+  });
+  std::cout << n << " temperatures:\n";
+  suite.run_and_report(options);
+  std::remove(text_file.c_str());
+  std::remove(data_file.c_str());
+}
+
+int main(int argc, char* argv[])
+{
+  // Ex9_08 --benchmark [n] [options] times text and binary files of n temperatures
+  if (argc > 1 && string{ argv[1] } == "--benchmark") {
+    size_t n{ 10'000'000 };
+    int arg{ 2 };
+    if (arg < argc && std::isdigit(static_cast<unsigned char>(argv[arg][0])))
+      n = std::stoul(argv[arg++]);
+    Benchmark_Options options;
+    options.samples = 5;
+    options.warmup_iterations = 1;
+    if (!parse_benchmark_options(argc, argv, arg, options)) {
+      std::cerr << "Usage: Ex9_08 --benchmark [n] [--samples N] [--warmup N] "
+                   "[--max-seconds S] [--filter TEXT] [--json FILE] [--no-pin]"
+                << std::endl;
+      exit(1);
+    }
+    benchmark(n, options);
+    return 0;
+  }
+
+  // Ex9_08 --export samples text writes the values in a sample file as text
+  if (argc > 1 && string{ argv[1] } == "--export") {
+    if (argc < 4) {
+      std::cerr << "Usage: Ex9_08 --export samples text" << std::endl;
+      exit(1);
+    }
+    std::ofstream text_out{ argv[3], std::ios_base::out | std::ios_base::trunc };
+    if (!text_out) {
+      std::cerr << argv[3] << " not open." << std::endl;
+      exit(1);
+    }
+    write_text(text_out, open_samples(argv[2]).values(), -1, '\n');
+    return 0;
+  }
+
+  // Ex9_08 [n] writes n temperatures - 50 by default
+  size_t n{ argc > 1 ? std::stoul(argv[1]) : 50 }; // Number of temperatures required
+  string file_name{ "temperatures.dat" };
+  std::random_device rd; // Non-determistic source
+  if (!generate_temperatures(file_name, n, rd())) {
+    std::cerr << file_name << " not written." << std::endl;
+    exit(1);
+  }
+
+  // List the contents of the file
+  auto temps_in = open_samples(file_name);
+  auto values = temps_in.values();
+  const size_t perline{ 10 };
+  size_t count{};
+  for (auto t : values)
+    std::cout << std::fixed << std::setprecision(2) << std::setw(5) << t
+              << ((++count % perline) ? " " : "\n");
+  std::cout << std::defaultfloat << "\n"
+            << values.size() << " temperatures, mean " << temps_in.header().mean
+            << " and standard deviation " << temps_in.header().sigma << ", seed "
+            << temps_in.header().seed << std::endl;
+
+  // Export the temperatures as text
+  string text_name{ "temperatures.txt" };
+  std::ofstream temps_out{ text_name, std::ios_base::out | std::ios_base::trunc };
+  write_text(temps_out, values, 2);
+}
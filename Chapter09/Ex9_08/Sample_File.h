@@ -0,0 +1,222 @@
+// Sample_File.h for Ex9_08
+// A binary file format for a column of samples, with a writer and a mapped reader
+// The file is a header followed by the values as one contiguous column of doubles in
+// the byte order of the processor. The header records the number of values, their type,
+// and the parameters of the distribution that generated them. Sample_Writer is an
+// output iterator target that collects values in a buffer and writes them in batches,
+// so nothing is formatted. Sample_File maps the file and presents the values in place
+// as a Sample_Span, so nothing is parsed or copied. write_text() converts values to
+// text with to_chars(), which is much faster than stream output.
+
+#ifndef SAMPLE_FILE_H
+#define SAMPLE_FILE_H
+
+#include <charconv> // For to_chars()
+#include <cstdint>  // For fixed width integer types
+#include <cstring>  // For memcmp(), memcpy()
+#include <fstream>  // For file streams
+#include <iterator> // For output_iterator_tag
+#include <ostream>  // For ostream class
+#include <string>   // For string class
+#include <vector>   // For vector container
+
+#include "Mapped_File.h"
+
+namespace sample_file {
+const char magic[8]{ 'S', 'T', 'L', 'S', 'A', 'M', 'P', '\0' };
+const uint32_t version{ 1 };
+const uint32_t byte_order{ 0x01020304 }; // Reads differently in the other byte order
+const uint32_t float64{ 1 };             // Type code for double values
+const size_t batch_size{ 8192 };         // Values written by each write
+
+// The header at the start of the file - the values follow immediately
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint32_t value_type; // Type code of the values
+  uint32_t value_size; // Bytes per value
+  uint64_t count;      // Number of values
+  uint64_t seed;       // Seed for the random number generator
+  double mean;         // Parameters of the distribution
+  double sigma;
+};
+static_assert(sizeof(Header) % sizeof(double) == 0, "Values must be aligned");
+} // namespace sample_file
+
+// A view of a contiguous sequence of samples
+class Sample_Span {
+private:
+  const double* first{};
+  size_t length{};
+
+public:
+  Sample_Span() = default;
+  Sample_Span(const double* data, size_t size)
+    : first(data)
+    , length(size)
+  {
+  }
+
+  const double* data() const { return first; }
+  size_t size() const { return length; }
+  bool empty() const { return length == 0; }
+  const double* begin() const { return first; }
+  const double* end() const { return first + length; }
+  double operator[](size_t i) const { return first[i]; }
+};
+
+// Writes a sample file - test the object before use to see if it opened
+class Sample_Writer {
+private:
+  std::ofstream out;
+  sample_file::Header header{};
+  std::vector<double> buffer;
+
+  void write_header()
+  {
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  }
+
+  void flush()
+  {
+    out.write(reinterpret_cast<const char*>(buffer.data()),
+              static_cast<std::streamsize>(buffer.size() * sizeof(double)));
+    header.count += buffer.size();
+    buffer.clear();
+  }
+
+public:
+  // Output iterator that adds each value assigned through it to the file
+  class iterator {
+  private:
+    Sample_Writer* writer;
+
+  public:
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+
+    explicit iterator(Sample_Writer& w)
+      : writer(&w)
+    {
+    }
+    iterator& operator=(double value)
+    {
+      writer->add(value);
+      return *this;
+    }
+    iterator& operator*() { return *this; }
+    iterator& operator++() { return *this; }
+    iterator& operator++(int) { return *this; }
+  };
+
+  Sample_Writer(const std::string& file_name, uint64_t seed, double mean, double sigma)
+    : out(file_name, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary)
+  {
+    std::memcpy(header.magic, sample_file::magic, sizeof(header.magic));
+    header.version = sample_file::version;
+    header.byte_order = sample_file::byte_order;
+    header.value_type = sample_file::float64;
+    header.value_size = sizeof(double);
+    header.seed = seed;
+    header.mean = mean;
+    header.sigma = sigma;
+    buffer.reserve(sample_file::batch_size);
+    write_header(); // Written again with the count when the file is closed
+  }
+
+  ~Sample_Writer()
+  {
+    if (out.is_open())
+      close();
+  }
+
+  Sample_Writer(const Sample_Writer&) = delete;
+  Sample_Writer& operator=(const Sample_Writer&) = delete;
+
+  explicit operator bool() const { return static_cast<bool>(out); }
+
+  void add(double value)
+  {
+    buffer.push_back(value);
+    if (buffer.size() == sample_file::batch_size)
+      flush();
+  }
+
+  iterator inserter() { return iterator{ *this }; }
+
+  // Write any buffered values and the final header - returns false if writing failed
+  bool close()
+  {
+    flush();
+    write_header();
+    out.close();
+    return static_cast<bool>(out);
+  }
+};
+
+// Reads a sample file by mapping it into memory - test the object before use
+class Sample_File {
+private:
+  Mapped_File file;
+  const sample_file::Header* header_ptr{};
+
+public:
+  explicit Sample_File(const std::string& file_name)
+    : file(file_name)
+  {
+    using namespace sample_file;
+    if (!file || file.size() < sizeof(Header))
+      return;
+    auto header = reinterpret_cast<const Header*>(file.data());
+    if (std::memcmp(header->magic, magic, sizeof(magic)) != 0
+        || header->version != version || header->byte_order != byte_order
+        || header->value_type != float64 || header->value_size != sizeof(double)
+        || header->count > (file.size() - sizeof(Header)) / sizeof(double))
+      return;
+    header_ptr = header;
+  }
+
+  explicit operator bool() const { return header_ptr != nullptr; }
+
+  const sample_file::Header& header() const { return *header_ptr; }
+
+  // The samples - the header size is a multiple of 8 bytes so they are aligned
+  Sample_Span values() const
+  {
+    auto first = reinterpret_cast<const double*>(file.data() + sizeof(*header_ptr));
+    return Sample_Span{ first, header_ptr->count };
+  }
+};
+
+// Write values as text separated by a character, with fixed precision digits after
+// the point, or as the shortest text that reads back as the same value if precision
+// is negative
+inline void write_text(std::ostream& out, Sample_Span values, int precision = -1,
+                       char separator = ' ')
+{
+  // Room for the longest value and separator - the shortest form is at most 24
+  // characters, and the fixed form has a sign, up to 309 digits before the point,
+  // the point, and precision digits after it
+  const size_t max_length{ precision < 0 ? 32 : 312 + static_cast<size_t>(precision) };
+  std::vector<char> text(sample_file::batch_size * 32 + max_length);
+  char* next{ text.data() };
+  for (auto value : values) {
+    auto result = precision < 0
+                    ? std::to_chars(next, next + max_length - 1, value)
+                    : std::to_chars(next, next + max_length - 1, value,
+                                    std::chars_format::fixed, precision);
+    next = result.ptr;
+    *next++ = separator;
+    if (next > text.data() + text.size() - max_length) {
+      out.write(text.data(), next - text.data());
+      next = text.data();
+    }
+  }
+  out.write(text.data(), next - text.data());
+}
+#endif
@@ -1,36 +0,0 @@
-// Ex9_09.cpp
-// Copying a file using stream buffer iterators
-
-#include <fstream>  // For file streams
-#include <iostream> // For standard streams
-#include <iterator> // For iterators and begin() and end()
-#include <string>   // For string class
-
-using std::string;
-
-int main()
-{
-  string file_name{ "dictionary.txt" };
-  std::ifstream file_in{ file_name };
-  if (!file_in) {
-    std::cerr << file_name << " not open." << std::endl;
-    exit(1);
-  }
-  string file_copy{ "dictionary_copy.txt" };
-  std::ofstream file_out{ file_copy, std::ios_base::out | std::ios_base::trunc };
-
-  std::istreambuf_iterator<char> in{ file_in };   // Input stream buffer iterator
-  std::istreambuf_iterator<char> end_in;          // End of stream buffer iterator
-  std::ostreambuf_iterator<char> out{ file_out }; // Output stream buffer iterator
-  while (in != end_in)
-    out = *in++; // Copy character from in to out
-
-  std::cout << "File copy completed." << std::endl;
-
-  // std::copy() would be much easier:
-  // std::copy(std::istreambuf_iterator<char> {file_in}, std::istreambuf_iterator<char> {},
-  //           std::ostreambuf_iterator<char>{file_out});
-
-  file_in.close(); // Close the file
-  file_out.close();
-}
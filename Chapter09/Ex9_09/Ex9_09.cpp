@@ -0,0 +1,178 @@
+// Ex9_09.cpp
+// Copying a file using stream buffer iterators, and faster ways to copy a file
+
+#include <algorithm> // For min()
+#include <cctype>    // For isdigit()
+#include <chrono>    // For clocks, duration, and time_point
+#include <cstdio>    // For remove()
+#include <fstream>   // For file streams
+#include <iomanip>   // For stream manipulators
+#include <iostream>  // For standard streams
+#include <iterator>  // For iterators and begin() and end()
+#include <random>    // For random number generator
+#include <string>    // For string class, stoul()
+#include <vector>    // For vector container
+
+#include "Benchmark.h"
+#include "File_Copy.h"
+
+using std::string;
+
+const Copy_Strategy strategies[]{ Copy_Strategy::stream_iterator, Copy_Strategy::buffered,
+                                  Copy_Strategy::kernel, Copy_Strategy::mapped,
+                                  Copy_Strategy::automatic };
+
+// Create a file of random bytes for copying
+bool make_test_file(const string& file_name, uint64_t size)
+{
+  std::ofstream out{ file_name,
+                     std::ios_base::out | std::ios_base::trunc | std::ios_base::binary };
+  std::mt19937_64 rng{ 42u };
+  std::vector<uint64_t> block(1 << 17); // 1 MB
+  for (uint64_t written{}; out && written < size; written += block.size() * 8) {
+    for (auto& value : block)
+      value = rng();
+    auto length = std::min<uint64_t>(block.size() * 8, size - written);
+    out.write(reinterpret_cast<const char*>(block.data()),
+              static_cast<std::streamsize>(length));
+  }
+  return static_cast<bool>(out);
+}
+
+// Read the whole of a file
+string read_file(const string& file_name)
+{
+  std::ifstream in{ file_name, std::ios_base::in | std::ios_base::binary };
+  return { std::istreambuf_iterator<char>{ in }, std::istreambuf_iterator<char>{} };
+}
+
+// Check that every strategy copies all of a file whose size is not known in advance -
+// a procfs file reports a size of 0 whatever it contains - returns false if one fails
+bool check_unsized_source()
+{
+  bool ok{ true };
+#if defined(__linux__)
+  string file_name{ "/proc/self/cmdline" };
+  string copy_name{ "copy_test.out" };
+  string contents{ read_file(file_name) };
+  for (auto strategy : strategies) {
+    auto result = copy_file(file_name, copy_name, strategy);
+    if (!result.copied || read_file(copy_name) != contents) {
+      std::cerr << file_name << " not copied by the " << strategy_name(strategy)
+                << " strategy: " << result.bytes << " of " << contents.size()
+                << " bytes." << std::endl;
+      ok = false;
+    }
+  }
+  std::remove(copy_name.c_str());
+#endif
+  return ok;
+}
+
+// Time each copy strategy for files of each size in MB and output the throughput
+void benchmark(const std::vector<uint64_t>& sizes, const Benchmark_Options& options)
+{
+  string copy_name{ "copy_test.out" };
+  for (auto megabytes : sizes) {
+    string file_name{ "copy_test_" + std::to_string(megabytes) + "MB.bin" };
+    uint64_t size{ megabytes << 20 };
+    if (!make_test_file(file_name, size)) {
+      std::cerr << file_name << " not written." << std::endl;
+      exit(1);
+    }
+
+    Benchmark_Suite suite{ "Ex9_09 file copy " + std::to_string(megabytes) + " MB" };
+    for (auto strategy : strategies)
+      suite.add(strategy_name(strategy), [&, strategy] {
+        if (!copy_file(file_name, copy_name, strategy).copied) {
+          std::cerr << file_name << " not copied." << std::endl;
+          exit(1);
+        }
+      });
+    std::cout << "\nCopying " << megabytes << " MB:\n";
+    auto results = suite.run_and_report(options);
+    for (const auto& result : results)
+      std::cout << std::left << std::setw(18) << result.name << std::right << std::fixed
+                << std::setprecision(0) << std::setw(10) << megabytes / result.median
+                << " MB/s" << std::defaultfloat << std::endl;
+    std::remove(file_name.c_str());
+    std::remove(copy_name.c_str());
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  // Ex9_09 --check checks that each strategy copies a file with no size in advance
+  if (argc > 1 && string{ argv[1] } == "--check") {
+    if (!check_unsized_source())
+      exit(1);
+    std::cout << "All strategies copied a file whose size is not known in advance."
+              << std::endl;
+    return 0;
+  }
+
+  // Ex9_09 --benchmark [MB...] [options] times copying files of each size
+  if (argc > 1 && string{ argv[1] } == "--benchmark") {
+    std::vector<uint64_t> sizes;
+    int arg{ 2 };
+    for (; arg < argc && std::isdigit(static_cast<unsigned char>(argv[arg][0])); ++arg)
+      sizes.push_back(std::stoull(argv[arg]));
+    if (sizes.empty())
+      sizes = { 1, 16, 256 };
+    Benchmark_Options options;
+    options.samples = 5;
+    options.warmup_iterations = 1;
+    if (!parse_benchmark_options(argc, argv, arg, options)) {
+      std::cerr << "Usage: Ex9_09 --benchmark [MB...] [--samples N] [--warmup N] "
+                   "[--max-seconds S] [--filter TEXT] [--json FILE] [--no-pin]"
+                << std::endl;
+      exit(1);
+    }
+    if (!check_unsized_source())
+      exit(1);
+    benchmark(sizes, options);
+    return 0;
+  }
+
+  // Ex9_09 [from [to [stream]]] copies a file
+  // With stream the file is copied with stream buffer iterators as before
+  string file_name{ argc > 1 ? argv[1] : "dictionary.txt" };
+  string file_copy{ argc > 2 ? argv[2] : "dictionary_copy.txt" };
+  bool use_iterators{ argc > 3 && string{ argv[3] } == "stream" };
+  std::ifstream file_in{ file_name };
+  if (!file_in) {
+    std::cerr << file_name << " not open." << std::endl;
+    exit(1);
+  }
+
+  if (use_iterators) {
+    std::ofstream file_out{ file_copy, std::ios_base::out | std::ios_base::trunc };
+    std::istreambuf_iterator<char> in{ file_in };   // Input stream buffer iterator
+    std::istreambuf_iterator<char> end_in;          // End of stream buffer iterator
+    std::ostreambuf_iterator<char> out{ file_out }; // Output stream buffer iterator
+    while (in != end_in)
+      out = *in++; // Copy character from in to out
+
+    // std::copy() would be much easier:
+    // std::copy(std::istreambuf_iterator<char> {file_in},
+    //           std::istreambuf_iterator<char> {},
+    //           std::ostreambuf_iterator<char>{file_out});
+    file_out.close();
+    std::cout << "File copy completed." << std::endl;
+  } else {
+    // Let copy_file() choose the fastest way to copy the file
+    file_in.close();
+    auto start_time = std::chrono::steady_clock::now();
+    auto result = copy_file(file_name, file_copy);
+    auto end_time = std::chrono::steady_clock::now();
+    std::chrono::duration<double> elapsed{ end_time - start_time };
+    if (!result.copied) {
+      std::cerr << file_name << " not copied." << std::endl;
+      exit(1);
+    }
+    std::cout << "File copy completed: " << result.bytes << " bytes using the "
+              << strategy_name(result.strategy) << " strategy in " << elapsed.count()
+              << " seconds." << std::endl;
+  }
+  file_in.close(); // Close the file
+}
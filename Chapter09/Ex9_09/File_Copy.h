@@ -0,0 +1,297 @@
+// File_Copy.h for Ex9_09
+// Copies files using one of several strategies
+// - stream_iterator copies a character at a time with stream buffer iterators
+// - buffered reads and writes blocks of 1 MB through a page-aligned buffer
+// - kernel asks the operating system to copy the data with copy_file_range(), or
+//   sendfile() if that is not supported, so the data is never copied into the process
+// - mapped maps the source file into memory and writes the file from the mapping
+// automatic uses kernel if it is available, then mapped, then buffered; each strategy
+// that fails before it writes anything hands over to the next. kernel and mapped copy
+// the number of bytes the file system reports, so for a source that is not a regular
+// file, or that reports a size of 0 - a pipe or a procfs file - they use buffered.
+
+#ifndef FILE_COPY_H
+#define FILE_COPY_H
+
+#include <algorithm> // For min()
+#include <cstdint>   // For uint64_t
+#include <cstdlib>   // For aligned_alloc(), free()
+#include <fstream>   // For file streams
+#include <iterator>  // For stream buffer iterators
+#include <memory>    // For unique_ptr
+#include <string>    // For string class
+#include <utility>   // For exchange()
+
+#include "Mapped_File.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define FILE_COPY_POSIX 1
+#include <cerrno>     // For errno
+#include <fcntl.h>    // For open()
+#include <sys/stat.h> // For fstat()
+#include <unistd.h>   // For read(), write(), close()
+#endif
+#if defined(__linux__)
+#include <sys/sendfile.h> // For sendfile()
+#endif
+
+enum class Copy_Strategy { automatic, stream_iterator, buffered, kernel, mapped };
+
+inline const char* strategy_name(Copy_Strategy strategy)
+{
+  switch (strategy) {
+  case Copy_Strategy::automatic:
+    return "automatic";
+  case Copy_Strategy::stream_iterator:
+    return "stream iterator";
+  case Copy_Strategy::buffered:
+    return "buffered";
+  case Copy_Strategy::kernel:
+    return "kernel";
+  case Copy_Strategy::mapped:
+    return "mapped";
+  }
+  return "unknown";
+}
+
+// Outcome of a copy
+struct Copy_Result {
+  bool copied{};            // true if the whole file was copied
+  Copy_Strategy strategy{}; // The strategy that was used
+  uint64_t bytes{};         // Number of bytes copied
+};
+
+namespace file_copy {
+const size_t buffer_size{ 1 << 20 }; // Bytes per read or write for buffered copies
+const size_t alignment{ 4096 };      // Buffer alignment - the usual page size
+
+inline Copy_Result copy_stream_iterator(const std::string& from, const std::string& to)
+{
+  Copy_Result result{ false, Copy_Strategy::stream_iterator };
+  std::ifstream file_in{ from, std::ios_base::in | std::ios_base::binary };
+  std::ofstream file_out{ to, std::ios_base::out | std::ios_base::trunc
+                                | std::ios_base::binary };
+  if (!file_in || !file_out)
+    return result;
+  std::istreambuf_iterator<char> in{ file_in }, end_in;
+  std::ostreambuf_iterator<char> out{ file_out };
+  while (in != end_in) {
+    out = *in++;
+    ++result.bytes;
+  }
+  result.copied = static_cast<bool>(file_out.flush());
+  return result;
+}
+
+#ifdef FILE_COPY_POSIX
+// Owns a file descriptor
+class File_Descriptor {
+private:
+  int fd{ -1 };
+
+public:
+  explicit File_Descriptor(int descriptor)
+    : fd(descriptor)
+  {
+  }
+  ~File_Descriptor()
+  {
+    if (fd >= 0)
+      ::close(fd);
+  }
+  File_Descriptor(const File_Descriptor&) = delete;
+  File_Descriptor& operator=(const File_Descriptor&) = delete;
+
+  explicit operator bool() const { return fd >= 0; }
+  int get() const { return fd; }
+
+  // Close the file and report whether buffered data was written successfully
+  bool close() { return ::close(std::exchange(fd, -1)) == 0; }
+};
+
+// Write all of a block, continuing after partial writes and interruptions
+inline bool write_all(int fd, const char* data, size_t length)
+{
+  while (length) {
+    auto written = ::write(fd, data, length);
+    if (written < 0 && errno == EINTR)
+      continue;
+    if (written <= 0)
+      return false;
+    data += written;
+    length -= static_cast<size_t>(written);
+  }
+  return true;
+}
+
+inline File_Descriptor open_source(const std::string& from)
+{
+  return File_Descriptor{ ::open(from.c_str(), O_RDONLY) };
+}
+
+inline File_Descriptor open_destination(const std::string& to)
+{
+  return File_Descriptor{ ::open(to.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644) };
+}
+
+// Get the size of a regular file - returns false if the size is not known in advance
+inline bool regular_file_size(int fd, uint64_t& size)
+{
+  struct stat info {};
+  if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0)
+    return false;
+  size = static_cast<uint64_t>(info.st_size);
+  return true;
+}
+#endif
+
+inline Copy_Result copy_buffered(const std::string& from, const std::string& to)
+{
+  Copy_Result result{ false, Copy_Strategy::buffered };
+  std::unique_ptr<char, decltype(&std::free)> buffer{
+    static_cast<char*>(std::aligned_alloc(alignment, buffer_size)), &std::free
+  };
+  if (!buffer)
+    return result;
+#ifdef FILE_COPY_POSIX
+  auto in = open_source(from);
+  if (!in)
+    return result;
+  auto out = open_destination(to);
+  if (!out)
+    return result;
+  while (true) {
+    auto count = ::read(in.get(), buffer.get(), buffer_size);
+    if (count < 0 && errno == EINTR)
+      continue;
+    if (count < 0)
+      return result;
+    if (count == 0)
+      break;
+    if (!write_all(out.get(), buffer.get(), static_cast<size_t>(count)))
+      return result;
+    result.bytes += static_cast<uint64_t>(count);
+  }
+  result.copied = out.close();
+#else
+  std::ifstream file_in{ from, std::ios_base::in | std::ios_base::binary };
+  std::ofstream file_out{ to, std::ios_base::out | std::ios_base::trunc
+                                | std::ios_base::binary };
+  if (!file_in || !file_out)
+    return result;
+  while (file_in.read(buffer.get(), buffer_size) || file_in.gcount()) {
+    file_out.write(buffer.get(), file_in.gcount());
+    result.bytes += static_cast<uint64_t>(file_in.gcount());
+  }
+  result.copied = static_cast<bool>(file_out.flush());
+#endif
+  return result;
+}
+
+// Copy with copy_file_range(), falling back to sendfile()
+// If neither can be used at the start, the result reports no bytes and not copied.
+inline Copy_Result copy_kernel(const std::string& from, const std::string& to)
+{
+  Copy_Result result{ false, Copy_Strategy::kernel };
+#if defined(__linux__)
+  auto in = open_source(from);
+  if (!in)
+    return result;
+  uint64_t size{};
+  if (!regular_file_size(in.get(), size))
+    return copy_buffered(from, to);
+  auto out = open_destination(to);
+  if (!out)
+    return result;
+  bool use_sendfile{};
+  while (result.bytes < size) {
+    auto chunk = static_cast<size_t>(std::min<uint64_t>(size - result.bytes, 1u << 30));
+    ssize_t count{ -1 };
+    if (!use_sendfile) {
+      count = ::copy_file_range(in.get(), nullptr, out.get(), nullptr, chunk, 0);
+      if (count < 0 && result.bytes == 0
+          && (errno == ENOSYS || errno == EXDEV || errno == EINVAL
+              || errno == EOPNOTSUPP)) {
+        use_sendfile = true; // Not supported for these files - try sendfile()
+        continue;
+      }
+    } else
+      count = ::sendfile(out.get(), in.get(), nullptr, chunk);
+    if (count < 0 && errno == EINTR)
+      continue;
+    if (count <= 0)
+      return result; // Error, or the file is shorter than it was
+    result.bytes += static_cast<uint64_t>(count);
+  }
+  result.copied = out.close();
+#else
+  (void)from;
+  (void)to;
+#endif
+  return result;
+}
+
+// Map the source file and write the mapped contents to the destination
+inline Copy_Result copy_mapped(const std::string& from, const std::string& to)
+{
+  Copy_Result result{ false, Copy_Strategy::mapped };
+#ifdef FILE_COPY_POSIX
+  {
+    auto source = open_source(from);
+    uint64_t size{};
+    if (source && !regular_file_size(source.get(), size))
+      return copy_buffered(from, to);
+  }
+#endif
+  Mapped_File in{ from };
+  if (!in)
+    return result;
+  in.sequential();
+#ifdef FILE_COPY_POSIX
+  auto out = open_destination(to);
+  if (!out)
+    return result;
+  for (size_t offset{}; offset < in.size(); offset += buffer_size) {
+    size_t length{ std::min(buffer_size, in.size() - offset) };
+    if (!write_all(out.get(), in.data() + offset, length))
+      return result;
+    result.bytes += length;
+  }
+  result.copied = out.close();
+#else
+  std::ofstream file_out{ to, std::ios_base::out | std::ios_base::trunc
+                                | std::ios_base::binary };
+  file_out.write(in.data(), in.size());
+  result.bytes = in.size();
+  result.copied = static_cast<bool>(file_out.flush());
+#endif
+  return result;
+}
+} // namespace file_copy
+
+// Copy a file using a strategy - automatic tries the fastest strategies first
+inline Copy_Result copy_file(const std::string& from, const std::string& to,
+                             Copy_Strategy strategy = Copy_Strategy::automatic)
+{
+  using namespace file_copy;
+  switch (strategy) {
+  case Copy_Strategy::stream_iterator:
+    return copy_stream_iterator(from, to);
+  case Copy_Strategy::buffered:
+    return copy_buffered(from, to);
+  case Copy_Strategy::kernel:
+    return copy_kernel(from, to);
+  case Copy_Strategy::mapped:
+    return copy_mapped(from, to);
+  case Copy_Strategy::automatic:
+    break;
+  }
+  using Copier = Copy_Result (*)(const std::string&, const std::string&);
+  for (Copier copy : { copy_kernel, copy_mapped }) {
+    auto result = copy(from, to);
+    if (result.copied || result.bytes) // Succeeded, or failed part way through
+      return result;
+  }
+  return copy_buffered(from, to);
+}
+#endif
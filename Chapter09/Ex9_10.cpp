@@ -1,51 +1,123 @@
 // Ex9_10.cpp
-// Using a string stream as the dictionary source to anagrams of a word
+// Using a memory-mapped dictionary as the source for anagrams of a word
 
-#include <algorithm> // For next_permutation()
+#include <algorithm> // For next_permutation(), shuffle()
+#include <cctype>    // For tolower()
+#include <chrono>    // For clocks, duration, and time_point
 #include <fstream>   // For file streams
+#include <iomanip>   // For stream manipulators
 #include <iostream>  // For standard streams
 #include <iterator>  // For iterators and begin() and end()
+#include <optional>  // For optional type
+#include <random>    // For random number generator
 #include <set>       // For set container
-#include <sstream>   // For string streams
 #include <string>    // For string class
 #include <vector>    // For vector container
 
+#include "Benchmark.h"
+#include "Dictionary_Index.h"
+#include "Mapped_Dictionary.h"
+
 using std::string;
+using namespace std::chrono;
 
-int main()
+// Compare loading the dictionary into a set<string> with mapping it into memory
+void compare_loaders(const string& file_in)
 {
-  string file_in{ "dictionary.txt" };
+  // The mapped dictionary is measured first so the memory released by the set does
+  // not hide the memory it uses
+  auto memory_before = resident_memory();
+  auto start_time = steady_clock::now();
+  Mapped_Dictionary mapped{ file_in };
+  duration<double> mapped_time{ steady_clock::now() - start_time };
+  auto mapped_memory = resident_memory() - memory_before;
+
+  memory_before = resident_memory();
+  start_time = steady_clock::now();
   std::ifstream in{ file_in };
-  if (!in) {
-    std::cerr << file_in << " not open." << std::endl;
-    exit(1);
+  std::set<string> dictionary{ std::istream_iterator<string>(in),
+                               std::istream_iterator<string>() };
+  duration<double> set_time{ steady_clock::now() - start_time };
+  auto set_memory = resident_memory() - memory_before;
+
+  // Look up every word in the dictionary in random order with each method
+  std::vector<std::string_view> queries{ std::begin(mapped), std::end(mapped) };
+  std::shuffle(std::begin(queries), std::end(queries), std::mt19937{ 42u });
+  size_t found{};
+  auto time_lookups = [&](auto lookup) {
+    found = 0;
+    auto start = steady_clock::now();
+    for (auto word : queries)
+      found += lookup(word);
+    do_not_optimize(found);
+    return duration<double>(steady_clock::now() - start).count() * 1e9 / queries.size();
+  };
+  auto set_lookup = time_lookups([&](std::string_view word) {
+    return dictionary.count(string{ word });
+  });
+  auto binary_lookup = time_lookups([&](std::string_view word) {
+    return mapped.binary_search(word);
+  });
+  auto hash_lookup = time_lookups([&](std::string_view word) {
+    return mapped.contains(word);
+  });
+
+  std::cout << std::fixed << std::setprecision(3) << "set<string>:       "
+            << dictionary.size() << " words loaded in " << set_time.count() * 1000
+            << " ms, resident memory +" << set_memory / 1024 << " KB, lookup "
+            << std::setprecision(0) << set_lookup << " ns\n"
+            << std::setprecision(3) << "Mapped_Dictionary: " << mapped.size()
+            << " words loaded in " << mapped_time.count() * 1000
+            << " ms, resident memory +" << mapped_memory / 1024 << " KB ("
+            << mapped.memory() / 1024 << " KB allocated)\n"
+            << std::setprecision(0) << "  binary search lookup " << binary_lookup
+            << " ns, hash lookup " << hash_lookup << " ns" << std::endl;
+  if (found != dictionary.size())
+    std::cout << "Only " << found << " words found." << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+  string file_in{ "dictionary.txt" };
+
+  // Ex9_10 --compare compares loading and searching the dictionary with std::set
+  if (argc > 1 && string{ argv[1] } == "--compare") {
+    compare_loaders(file_in);
+    return 0;
   }
-  std::stringstream instr; // String stream for file contents
-  instr << in.rdbuf();
 
-  // std::copy(std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>(),
-  //                                              std::ostreambuf_iterator<char>{instr});
-  in.close(); // Close the file
+  // Use the prebuilt index if it is current, otherwise the words in the text file
+  Dictionary_Index index{ "dictionary.idx", file_in };
+  std::optional<Mapped_Dictionary> dictionary;
+  if (!index) {
+    dictionary.emplace(file_in); // Words refer to the mapped file
+    if (!*dictionary) {
+      std::cerr << file_in << " not open." << std::endl;
+      exit(1);
+    }
+  }
 
   std::vector<string> words;
   string word;
-  auto end_iter = std::istream_iterator<string>{}; // End-of-stream iterator
   while (true) {
     std::cout << "\nEnter a word, or Ctrl+D to end: ";
     if ((std::cin >> word).eof())
       break;
 
-    string word_copy{ word };
-    do {
-      instr.clear();  // Reset string stream EOF
-      instr.seekg(0); // String stream position at beginning
-
-      // Use find() to search instr for word
-      if (std::find(std::istream_iterator<string>(instr), end_iter, word) != end_iter)
-        words.push_back(word); // Store the word found
+    if (index) { // One lookup of the sorted letters finds all the anagrams
+      auto found = index.anagrams(word);
+      words.assign(std::begin(found), std::end(found));
+    } else { // Look up every permutation - n! lookups for a word of n distinct letters
+      for (auto& ch : word) // The dictionary is lowercase, like the index signatures
+        ch = static_cast<char>(std::tolower(static_cast<unsigned char>(ch)));
+      string word_copy{ word };
+      do {
+        if (dictionary->contains(word))
+          words.push_back(word); // Store the word found
 
-      std::next_permutation(std::begin(word), std::end(word));
-    } while (word != word_copy);
+        std::next_permutation(std::begin(word), std::end(word));
+      } while (word != word_copy);
+    }
 
     std::copy(std::begin(words), std::end(words),
               std::ostream_iterator<string>{ std::cout, " " });
@@ -0,0 +1,204 @@
+// Ex10_01.cpp
+// Least squares regression
+
+#include <algorithm>    // For min()
+#include <charconv>     // For from_chars()
+#include <chrono>       // For clocks, duration, and time_point
+#include <fstream>      // For file streams
+#include <iomanip>      // For stream manipulators
+#include <iostream>     // For standard streams
+#include <random>       // For distributions and random number generator
+#include <string>       // For string class, stoul()
+#include <system_error> // For errc
+#include <thread>       // For hardware_concurrency()
+#include <vector>       // For vector container
+
+#include "Benchmark.h"
+#include "Least_Squares.h"
+#include "Mapped_File.h"
+#include "Thread_Pool.h"
+
+using std::string;
+
+// Parse a line of a data file - a name followed by k x values and a y value
+// Returns false if the line does not contain them all.
+bool parse_point(const char* first, const char* last, std::vector<double>& x, double& y)
+{
+  while (first != last && (*first == ' ' || *first == '\t'))
+    ++first;
+  while (first != last && *first != ' ' && *first != '\t') // Skip the name
+    ++first;
+  for (size_t i{}; i <= x.size(); ++i) {
+    while (first != last && (*first == ' ' || *first == '\t'))
+      ++first;
+    auto result = std::from_chars(first, last, i < x.size() ? x[i] : y);
+    if (result.ec != std::errc{})
+      return false;
+    first = result.ptr;
+  }
+  return true;
+}
+
+// Add the points from the lines in [first, last) to an accumulator
+// Returns the number of lines that could not be parsed.
+size_t add_points(const char* first, const char* last, Least_Squares& sums)
+{
+  std::vector<double> x(sums.regressors());
+  double y{};
+  size_t rejected{};
+  while (first != last) {
+    auto end_line = std::find(first, last, '\n');
+    if (parse_point(first, end_line, x, y))
+      sums.add(x.data(), y);
+    else if (std::find_if(first, end_line, [](char ch) { return ch > ' '; }) != end_line)
+      ++rejected; // Not a blank line
+    first = end_line == last ? last : end_line + 1;
+  }
+  return rejected;
+}
+
+// Fit a regression to the points in a file in a single pass using n_threads threads
+// The file is mapped into memory and divided into chunks at line boundaries. Each
+// chunk is processed by a separate task with its own accumulator, and these are merged.
+Least_Squares fit_file(const string& file_name, size_t regressors, size_t n_threads,
+                       size_t& rejected)
+{
+  Mapped_File file{ file_name };
+  if (!file) {
+    std::cerr << file_name << " not open." << std::endl;
+    exit(1);
+  }
+  file.sequential();
+
+  size_t n_chunks{ 4 * n_threads }; // More chunks than threads balances the work
+  std::vector<const char*> bounds{ file.begin() };
+  for (size_t i{ 1 }; i < n_chunks; ++i) {
+    auto split = std::max(bounds.back(), file.begin() + i * file.size() / n_chunks);
+    split = std::find(split, file.end(), '\n');
+    bounds.push_back(split == file.end() ? split : split + 1);
+  }
+  bounds.push_back(file.end());
+
+  std::vector<Least_Squares> sums(n_chunks, Least_Squares{ regressors });
+  std::vector<size_t> bad_lines(n_chunks);
+  Thread_Pool pool{ n_threads };
+  pool.parallel_for(n_chunks, [&](size_t i) {
+    bad_lines[i] = add_points(bounds[i], bounds[i + 1], sums[i]);
+  });
+
+  rejected = 0;
+  for (size_t i{ 1 }; i < n_chunks; ++i) {
+    sums[0] += sums[i];
+    rejected += bad_lines[i];
+  }
+  rejected += bad_lines[0];
+  return sums[0];
+}
+
+// Write n random points with k x values to a file
+// The y values are 1*x1 + 2*x2 + ... + k*xk + 10 plus random noise.
+void generate_file(const string& file_name, size_t n, size_t regressors)
+{
+  std::ofstream out{ file_name, std::ios_base::out | std::ios_base::trunc };
+  if (!out) {
+    std::cerr << file_name << " not open." << std::endl;
+    exit(1);
+  }
+  std::mt19937 rng{ 42u };
+  std::uniform_real_distribution<double> x_values{ 0.0, 100.0 };
+  std::normal_distribution<double> noise{ 0.0, 1.0 };
+  std::vector<double> x(regressors);
+  for (size_t i{}; i < n; ++i) {
+    double y{ 10.0 + noise(rng) };
+    out << 'p' << i;
+    for (size_t j{}; j < regressors; ++j) {
+      x[j] = x_values(rng);
+      y += (j + 1) * x[j];
+      out << ' ' << x[j];
+    }
+    out << ' ' << y << '\n';
+  }
+}
+
+// Output a fitted equation
+void print_regression(const Regression& fit)
+{
+  if (!fit.valid) {
+    std::cout << "Not enough independent points to fit an equation." << std::endl;
+    return;
+  }
+  std::cout << std::fixed << std::setprecision(3) << "\ny = ";
+  for (size_t i{}; i < fit.slopes.size(); ++i) // x1, x2, ... when there is more than one
+    std::cout << fit.slopes[i] << "*x"
+              << (fit.slopes.size() > 1 ? std::to_string(i + 1) : "") << " + ";
+  std::cout << fit.intercept << "   R-squared = " << fit.r_squared << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+  // Ex10_01 --generate file n [k] writes n random points with k x values to a file
+  if (argc > 1 && string{ argv[1] } == "--generate") {
+    if (argc < 4) {
+      std::cerr << "Usage: Ex10_01 --generate file n [k]" << std::endl;
+      exit(1);
+    }
+    generate_file(argv[2], std::stoul(argv[3]), argc > 4 ? std::stoul(argv[4]) : 1);
+    return 0;
+  }
+
+  // Ex10_01 --fit file [k [threads]] fits an equation to points with k x values
+  if (argc > 1 && string{ argv[1] } == "--fit") {
+    if (argc < 3) {
+      std::cerr << "Usage: Ex10_01 --fit file [k [threads]]" << std::endl;
+      exit(1);
+    }
+    size_t regressors{ argc > 3 ? std::stoul(argv[3]) : 1 };
+    size_t n_threads{ argc > 4 ? std::stoul(argv[4])
+                               : std::max(1u, std::thread::hardware_concurrency()) };
+    n_threads = std::max(n_threads, size_t{ 1 }); // There must be at least one chunk
+    size_t rejected{};
+    auto start_time = std::chrono::steady_clock::now();
+    auto sums = fit_file(argv[2], regressors, n_threads, rejected);
+    auto end_time = std::chrono::steady_clock::now();
+    auto elapsed = end_time - start_time.time_since_epoch();
+    std::cout << "Time to read " << sums.count() << " points using " << n_threads
+              << " threads is ";
+    print_timepoint(elapsed, 6);
+    if (rejected)
+      std::cout << rejected << " lines could not be read." << std::endl;
+    print_regression(sums.fit());
+    return 0;
+  }
+
+  // File contains country_name renewables_per_person kwh_cost
+  string file_in{ "G:/Beginning_STL/renewables_vs_kwh_cost.txt" };
+  std::ifstream in{ file_in };
+
+  if (!in) // Verify  we have a file
+  {
+    std::cerr << file_in << " not open." << std::endl;
+    exit(1);
+  }
+
+  Least_Squares sums; // Sums for renewables per head (x) and kwh cost (y)
+
+  // Read the file and show the data
+  std::cout << "   Country   "
+            << " Watts per Head "
+            << " kwh cost(cents) " << std::endl;
+  while (true) {
+    string country;
+    double renewables{};
+    double kwh_cost{};
+
+    if ((in >> country).eof())
+      break; // EOF read - we are done
+    in >> renewables >> kwh_cost;
+    sums.add(renewables, kwh_cost);
+    std::cout << std::left << std::setw(12) << country // Output the record
+              << std::right << std::fixed << std::setprecision(2) << std::setw(12)
+              << renewables << std::setw(16) << kwh_cost << std::endl;
+  }
+
+  print_regression(sums.fit()); // Output equation for regression line
+}
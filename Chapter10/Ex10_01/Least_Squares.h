@@ -0,0 +1,171 @@
+// Least_Squares.h for Ex10_01
+// Accumulates the sums for a least squares regression one point at a time
+// A point is added by updating running sums, so the data never has to be stored and
+// any amount can be processed in constant memory. The sums use compensated (Kahan)
+// summation so rounding errors do not build up over millions of points. Accumulators
+// for separate parts of the data - processed by separate threads, for instance - can
+// be merged, and the result is the same as if all the points were added to one.
+// A point has any number of x values (regressors) and one y value, and the fitted
+// equation is y = b1*x1 + b2*x2 + ... + bk*xk + intercept.
+
+#ifndef LEAST_SQUARES_H
+#define LEAST_SQUARES_H
+
+#include <cmath>   // For abs()
+#include <cstddef> // For size_t
+#include <utility> // For swap()
+#include <vector>  // For vector container
+
+// A sum with a running compensation for the low-order bits lost in each addition
+// This is Neumaier's form of Kahan summation, which also works when the value added
+// is larger than the sum so far.
+class Kahan_Sum {
+private:
+  double sum{};
+  double compensation{}; // Total of the rounding errors
+
+public:
+  Kahan_Sum& operator+=(double value)
+  {
+    double total{ sum + value };
+    if (std::abs(sum) >= std::abs(value))
+      compensation += (sum - total) + value; // Low-order bits of value that were lost
+    else
+      compensation += (value - total) + sum; // Low-order bits of sum that were lost
+    sum = total;
+    return *this;
+  }
+
+  Kahan_Sum& operator+=(const Kahan_Sum& other)
+  {
+    *this += other.sum;
+    compensation += other.compensation;
+    return *this;
+  }
+
+  double value() const { return sum + compensation; }
+};
+
+// The fitted equation
+struct Regression {
+  std::vector<double> slopes; // Coefficient for each x value
+  double intercept{};
+  double r_squared{};         // Proportion of the variation in y that is explained
+  bool valid{};               // false if there is too little data to fit
+};
+
+class Least_Squares {
+private:
+  size_t k{};                       // Number of x values in each point
+  size_t n{};                       // Number of points
+  std::vector<Kahan_Sum> sum_x;     // Sums of each x value
+  std::vector<Kahan_Sum> sum_xx;    // Sums of xi*xj for i <= j, row by row
+  std::vector<Kahan_Sum> sum_xy;    // Sums of each x value times y
+  Kahan_Sum sum_y;
+  Kahan_Sum sum_yy;
+
+public:
+  explicit Least_Squares(size_t regressors = 1)
+    : k(regressors)
+    , sum_x(regressors)
+    , sum_xx(regressors * (regressors + 1) / 2)
+    , sum_xy(regressors)
+  {
+  }
+
+  size_t regressors() const { return k; }
+  size_t count() const { return n; }
+
+  // Add a point with k x values
+  void add(const double* x, double y)
+  {
+    ++n;
+    sum_y += y;
+    sum_yy += y * y;
+    for (size_t i{}, index{}; i < k; ++i) {
+      sum_x[i] += x[i];
+      sum_xy[i] += x[i] * y;
+      for (size_t j{ i }; j < k; ++j)
+        sum_xx[index++] += x[i] * x[j];
+    }
+  }
+
+  // Add a point with one x value
+  void add(double x, double y) { add(&x, y); }
+
+  // Merge the sums for another set of points with the same number of x values
+  Least_Squares& operator+=(const Least_Squares& other)
+  {
+    n += other.n;
+    sum_y += other.sum_y;
+    sum_yy += other.sum_yy;
+    for (size_t i{}; i < k; ++i) {
+      sum_x[i] += other.sum_x[i];
+      sum_xy[i] += other.sum_xy[i];
+    }
+    for (size_t i{}; i < sum_xx.size(); ++i)
+      sum_xx[i] += other.sum_xx[i];
+    return *this;
+  }
+
+  // Fit the equation to the points added so far
+  // The sums are converted to sums of products of deviations from the means, which
+  // gives k equations for the slopes; these are solved by Gaussian elimination.
+  Regression fit() const
+  {
+    Regression result;
+    result.slopes.resize(k);
+    if (n <= k)
+      return result;
+
+    std::vector<double> a(k * (k + 1)); // k rows of k+1 elements - rhs in the last
+    double sy{ sum_y.value() };
+    for (size_t i{}, index{}; i < k; ++i) {
+      double sxi{ sum_x[i].value() };
+      for (size_t j{ i }; j < k; ++j, ++index) {
+        double cov{ sum_xx[index].value() - sxi * sum_x[j].value() / n };
+        a[i * (k + 1) + j] = a[j * (k + 1) + i] = cov;
+      }
+      a[i * (k + 1) + k] = sum_xy[i].value() - sxi * sy / n;
+    }
+
+    // Eliminate with partial pivoting
+    for (size_t row{}; row < k; ++row) {
+      size_t best{ row };
+      for (size_t i{ row + 1 }; i < k; ++i)
+        if (std::abs(a[i * (k + 1) + row]) > std::abs(a[best * (k + 1) + row]))
+          best = i;
+      if (a[best * (k + 1) + row] == 0.0)
+        return result; // The x values are not independent
+      for (size_t j{}; j <= k; ++j)
+        std::swap(a[row * (k + 1) + j], a[best * (k + 1) + j]);
+      for (size_t i{ row + 1 }; i < k; ++i) {
+        double factor{ a[i * (k + 1) + row] / a[row * (k + 1) + row] };
+        for (size_t j{ row }; j <= k; ++j)
+          a[i * (k + 1) + j] -= factor * a[row * (k + 1) + j];
+      }
+    }
+
+    // Back substitution
+    for (size_t row{ k }; row-- > 0;) {
+      double value{ a[row * (k + 1) + k] };
+      for (size_t j{ row + 1 }; j < k; ++j)
+        value -= a[row * (k + 1) + j] * result.slopes[j];
+      result.slopes[row] = value / a[row * (k + 1) + row];
+    }
+
+    // The intercept puts the point of means on the line
+    result.intercept = sy;
+    double explained{}; // Variation in y explained by the equation
+    for (size_t i{}; i < k; ++i) {
+      result.intercept -= result.slopes[i] * sum_x[i].value();
+      explained += result.slopes[i] * (sum_xy[i].value() - sum_x[i].value() * sy / n);
+    }
+    result.intercept /= n;
+    double total{ sum_yy.value() - sy * sy / n }; // Total variation in y
+    result.r_squared = total > 0.0 ? explained / total : 1.0;
+    result.valid = true;
+    return result;
+  }
+};
+#endif
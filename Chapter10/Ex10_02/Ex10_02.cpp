@@ -0,0 +1,121 @@
+// Ex10_02.cpp
+// Dropping bricks safely from a tall building using valarray objects
+
+#include <algorithm> // For for_each()
+#include <cctype>    // For isdigit()
+#include <cmath>     // For sqrt(), round()
+#include <iomanip>   // For stream manipulators
+#include <iostream>  // For standard streams
+#include <iterator>  // For begin() and end()
+#include <numeric>   // For iota()
+#include <string>    // For string class, stoul()
+#include <valarray>  // For valarray
+
+#include "Benchmark.h"
+#include "Lazy_Array.h"
+
+const static double g{ 32.0 }; // Acceleration due to gravity ft/sec/sec
+
+// Time the calculation of velocities in mph from the times for n time values,
+// computed with valarray operations and with a fused Lazy_Array expression
+void benchmark(size_t n, const Benchmark_Options& options)
+{
+  auto distance = [](double t) { return 0.5 * g * t * t; };
+  auto speed_squared = [](double d) { return 2 * g * d; };
+  auto mph = [](double v) { return v * 60 / 88; };
+
+  std::valarray<double> times(n);
+  std::iota(std::begin(times), std::end(times), 0);
+  Lazy_Array<double> lazy_times{ times };
+  std::valarray<double> v_mph;
+  Lazy_Array<double> lazy_mph{ n };
+
+  // Each valarray operation reads one array and writes another: 4 steps make 8 passes
+  // The fused expression reads times and writes the result: 2 passes
+  const size_t valarray_passes{ 8 }, fused_passes{ 2 };
+  Benchmark_Suite suite{ "Ex10_02 brick velocities" };
+  suite.add("valarray", [&] {
+    std::valarray<double> distances = times.apply(distance);
+    std::valarray<double> v_fps = sqrt(distances.apply(speed_squared));
+    v_mph = v_fps.apply(mph);
+    do_not_optimize(v_mph[n - 1]);
+  });
+  suite.add("Lazy_Array", [&] {
+    lazy_mph = sqrt(lazy_times.apply(distance).apply(speed_squared)).apply(mph);
+    do_not_optimize(lazy_mph[n - 1]);
+  });
+  auto results = suite.run_and_report(options);
+
+  for (const auto& result : results) {
+    auto passes = result.name == "valarray" ? valarray_passes : fused_passes;
+    std::cout << std::left << std::setw(12) << result.name << std::right << passes
+              << " memory passes, " << std::fixed << std::setprecision(2)
+              << passes * n * sizeof(double) / result.median / 1e9 << " GB/s"
+              << std::defaultfloat << std::endl;
+  }
+  if (results.size() == 2)
+    std::cout << "Fused expression speedup: " << std::fixed << std::setprecision(2)
+              << results[0].median / results[1].median << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+  // Ex10_02 --benchmark [n] [options] compares valarray with Lazy_Array for n values
+  if (argc > 1 && std::string{ argv[1] } == "--benchmark") {
+    int arg{ 2 };
+    size_t n{ 100'000'000 };
+    if (arg < argc && std::isdigit(static_cast<unsigned char>(argv[arg][0])))
+      n = std::stoul(argv[arg++]);
+    Benchmark_Options options;
+    options.samples = 5;
+    options.warmup_iterations = 1;
+    if (n < 2 || !parse_benchmark_options(argc, argv, arg, options)) {
+      std::cerr << "Usage: Ex10_02 --benchmark [n] [--samples N] [--warmup N] "
+                   "[--max-seconds S] [--filter TEXT] [--json FILE] [--no-pin]"
+                << std::endl;
+      exit(1);
+    }
+    benchmark(n, options);
+    return 0;
+  }
+
+  double height{}; // Building height
+  std::cout << "Enter the approximate height of the building in feet: ";
+  std::cin >> height;
+
+  // Calculate brick flight time in seconds
+  double end_time{ std::sqrt(2 * height / g) };
+  size_t max_time{ 1 + static_cast<size_t>(end_time + 0.5) };
+
+  Lazy_Array<double> times(max_time + 1);           // Array to accommodate times
+  std::iota(std::begin(times), std::end(times), 0); // Initialize: 0 to max_time
+  *(std::end(times) - 1) = end_time;                // Set the last time value
+
+  // Calculate distances each second
+  Lazy_Array<double> distances = times.apply([](double t) { return 0.5 * g * t * t; });
+
+  // Calculate speed each second - the expression is evaluated in a single loop
+  Lazy_Array<double> v_fps = sqrt(distances.apply([](double d) { return 2 * g * d; }));
+
+  // Lambda expression to output results
+  auto print
+    = [](double v) { std::cout << std::setw(5) << static_cast<int>(std::round(v)); };
+
+  // Output the times - the last is a special case...
+  std::cout << "Time (seconds): ";
+  std::for_each(std::begin(times), std::end(times) - 1, print);
+  std::cout << std::setw(5) << std::fixed << std::setprecision(2)
+            << *(std::end(times) - 1);
+
+  std::cout << "\nDistances(feet):";
+  std::for_each(std::begin(distances), std::end(distances), print);
+
+  std::cout << "\nVelocity(fps):  ";
+  std::for_each(std::begin(v_fps), std::end(v_fps), print);
+
+  // Output velocities in mph - each is computed as the expression is iterated over
+  auto v_mph = v_fps.apply([](double v) { return v * 60 / 88; });
+  std::cout << "\nVelocity(mph):  ";
+  std::for_each(std::begin(v_mph), std::end(v_mph), print);
+  std::cout << std::endl;
+}
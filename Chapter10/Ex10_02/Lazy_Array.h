@@ -0,0 +1,252 @@
+// Lazy_Array.h for Ex10_02
+// An array type whose element-wise operations are evaluated lazily
+// Applying a function or an operator to a Lazy_Array does not compute anything; it
+// returns a small expression object that records the operation and its operands. The
+// expression is evaluated when it is assigned to a Lazy_Array, in a single loop that
+// computes each result element from the source elements, so a chain of operations
+// reads the source array once and writes the result once with no temporary arrays.
+// Expressions can also be iterated over with begin() and end(), which computes each
+// element as it is dereferenced.
+
+#ifndef LAZY_ARRAY_H
+#define LAZY_ARRAY_H
+
+#include <cmath>       // For sqrt(), abs()
+#include <cstddef>     // For size_t, ptrdiff_t
+#include <functional>  // For plus, minus, multiplies, divides
+#include <iterator>    // For iterator tags
+#include <type_traits> // For invoke_result, decay
+#include <valarray>    // For valarray
+
+template <typename T>
+class Lazy_Array;
+
+// Iterates over the elements of an expression, computing each one when dereferenced
+template <typename E>
+class Expression_Iterator {
+private:
+  const E* expression{};
+  size_t index{};
+
+public:
+  using iterator_category = std::input_iterator_tag;
+  using value_type = typename E::value_type;
+  using difference_type = std::ptrdiff_t;
+  using pointer = void;
+  using reference = value_type; // Elements are computed, so there is nothing to refer to
+
+  Expression_Iterator(const E* expr, size_t i)
+    : expression(expr)
+    , index(i)
+  {
+  }
+
+  value_type operator*() const { return (*expression)[index]; }
+
+  Expression_Iterator& operator++()
+  {
+    ++index;
+    return *this;
+  }
+  Expression_Iterator operator++(int) { return { expression, index++ }; }
+
+  Expression_Iterator operator+(difference_type n) const
+  {
+    return { expression, index + n };
+  }
+  Expression_Iterator operator-(difference_type n) const
+  {
+    return { expression, index - n };
+  }
+  difference_type operator-(const Expression_Iterator& other) const
+  {
+    return static_cast<difference_type>(index - other.index);
+  }
+
+  bool operator==(const Expression_Iterator& other) const
+  {
+    return index == other.index;
+  }
+  bool operator!=(const Expression_Iterator& other) const
+  {
+    return index != other.index;
+  }
+};
+
+template <typename E, typename F>
+class Unary_Expression;
+
+// Base for all array expressions - E is the expression type
+template <typename E>
+class Array_Expression {
+public:
+  const E& self() const { return static_cast<const E&>(*this); }
+
+  // Apply a function to each element
+  template <typename F>
+  Unary_Expression<E, F> apply(F f) const;
+
+  Expression_Iterator<E> begin() const { return { &self(), 0 }; }
+  Expression_Iterator<E> end() const { return { &self(), self().size() }; }
+};
+
+// Expressions hold the expressions they are built from by value because they are
+// small temporary objects, but hold arrays by reference so the data is not copied
+template <typename E>
+struct Operand {
+  using type = E;
+};
+template <typename T>
+struct Operand<Lazy_Array<T>> {
+  using type = const Lazy_Array<T>&;
+};
+
+// The result of applying a function to each element of an expression
+template <typename E, typename F>
+class Unary_Expression : public Array_Expression<Unary_Expression<E, F>> {
+private:
+  typename Operand<E>::type operand;
+  F function;
+
+public:
+  using value_type = std::decay_t<std::invoke_result_t<F, typename E::value_type>>;
+
+  Unary_Expression(const E& expr, F f)
+    : operand(expr)
+    , function(f)
+  {
+  }
+
+  size_t size() const { return operand.size(); }
+  value_type operator[](size_t i) const { return function(operand[i]); }
+};
+
+template <typename E>
+template <typename F>
+Unary_Expression<E, F> Array_Expression<E>::apply(F f) const
+{
+  return { self(), f };
+}
+
+// The result of applying a binary operation to corresponding elements of two
+// expressions of the same size
+template <typename L, typename R, typename Op>
+class Binary_Expression : public Array_Expression<Binary_Expression<L, R, Op>> {
+private:
+  typename Operand<L>::type left;
+  typename Operand<R>::type right;
+  Op op;
+
+public:
+  using value_type = std::decay_t<
+    std::invoke_result_t<Op, typename L::value_type, typename R::value_type>>;
+
+  Binary_Expression(const L& lhs, const R& rhs, Op operation)
+    : left(lhs)
+    , right(rhs)
+    , op(operation)
+  {
+  }
+
+  size_t size() const { return left.size(); }
+  value_type operator[](size_t i) const { return op(left[i], right[i]); }
+};
+
+// An array that evaluates an expression when the expression is assigned to it
+template <typename T>
+class Lazy_Array : public Array_Expression<Lazy_Array<T>> {
+private:
+  std::valarray<T> data;
+
+  // Evaluate an expression into data in one pass
+  template <typename E>
+  void evaluate(const Array_Expression<E>& expr)
+  {
+    const E& source{ expr.self() };
+    size_t n{ source.size() };
+    if (data.size() != n)
+      data.resize(n);
+    T* result{ std::begin(data) };
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC ivdep // Each result depends only on source elements with the same index
+#endif
+    for (size_t i{}; i < n; ++i)
+      result[i] = source[i];
+  }
+
+public:
+  using value_type = T;
+
+  explicit Lazy_Array(size_t n = 0, const T& value = T{})
+    : data(value, n)
+  {
+  }
+
+  explicit Lazy_Array(const std::valarray<T>& values)
+    : data(values)
+  {
+  }
+
+  template <typename E>
+  Lazy_Array(const Array_Expression<E>& expr)
+  {
+    evaluate(expr);
+  }
+
+  template <typename E>
+  Lazy_Array& operator=(const Array_Expression<E>& expr)
+  {
+    evaluate(expr);
+    return *this;
+  }
+
+  size_t size() const { return data.size(); }
+  T& operator[](size_t i) { return data[i]; }
+  const T& operator[](size_t i) const { return data[i]; }
+
+  // Arrays are iterated over with pointers to the elements
+  T* begin() { return std::begin(data); }
+  T* end() { return std::end(data); }
+  const T* begin() const { return std::begin(data); }
+  const T* end() const { return std::end(data); }
+
+  const std::valarray<T>& values() const { return data; }
+};
+
+// Element-wise functions
+template <typename E>
+auto sqrt(const Array_Expression<E>& expr)
+{
+  return expr.apply([](auto x) { return std::sqrt(x); });
+}
+
+template <typename E>
+auto abs(const Array_Expression<E>& expr)
+{
+  return expr.apply([](auto x) { return std::abs(x); });
+}
+
+// Element-wise operators for two expressions, and for an expression and a value
+#define LAZY_ARRAY_OPERATOR(op, function)                                               \
+  template <typename L, typename R>                                                     \
+  auto operator op(const Array_Expression<L>& lhs, const Array_Expression<R>& rhs)      \
+  {                                                                                     \
+    return Binary_Expression<L, R, function>{ lhs.self(), rhs.self(), function{} };     \
+  }                                                                                     \
+  template <typename E>                                                                 \
+  auto operator op(const Array_Expression<E>& lhs, typename E::value_type value)        \
+  {                                                                                     \
+    return lhs.apply([value](auto x) { return x op value; });                          \
+  }                                                                                     \
+  template <typename E>                                                                 \
+  auto operator op(typename E::value_type value, const Array_Expression<E>& rhs)        \
+  {                                                                                     \
+    return rhs.apply([value](auto x) { return value op x; });                          \
+  }
+
+LAZY_ARRAY_OPERATOR(+, std::plus<>)
+LAZY_ARRAY_OPERATOR(-, std::minus<>)
+LAZY_ARRAY_OPERATOR(*, std::multiplies<>)
+LAZY_ARRAY_OPERATOR(/, std::divides<>)
+#undef LAZY_ARRAY_OPERATOR
+#endif
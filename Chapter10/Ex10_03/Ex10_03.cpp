@@ -2,6 +2,8 @@
 // Using the Gaussian Elimination method to solve a set of liear equations
 
 #include <algorithm> // For generate_n()
+#include <chrono>    // For clocks and duration
+#include <fstream>   // For file streams
 #include <iomanip>   // For stream manipulators
 #include <iostream>  // For standard streams
 #include <iterator>  // For ostream iterator
@@ -10,9 +12,12 @@
 #include <valarray>  // For valarray, slice, abs()
 #include <vector>    // For vector container
 
+#include "Matrix_IO.h"
+
 using std::slice;
 using std::string;
 using std::valarray;
+using namespace std::chrono;
 
 // Function prototypes
 valarray<double> get_data(size_t n);
@@ -20,12 +25,42 @@ void reduce_matrix(valarray<double>& equations, std::vector<slice>& row_slices);
 valarray<double> back_substitution(valarray<double>& equations,
                                    const std::vector<slice>& row_slices);
 
-int main()
+int main(int argc, char* argv[])
 {
   size_t n_rows{};
-  std::cout << "Enter the number of variables: ";
-  std::cin >> n_rows;
-  auto equations = get_data(n_rows);
+  valarray<double> equations;
+
+  // Ex10_03 --load stream|fast|binary file reads the equations from a file
+  if (argc > 3 && string{ argv[1] } == "--load") {
+    string loader{ argv[2] }, file_name{ argv[3] };
+    bool loaded{};
+    auto start_time = steady_clock::now();
+    if (loader == "binary") {
+      Binary_Matrix mapped{ file_name };
+      if ((loaded = static_cast<bool>(mapped))) {
+        n_rows = mapped.unknowns();
+        equations = mapped.values();
+      }
+    } else if (loader == "fast") {
+      loaded = load_text_matrix(file_name, equations, n_rows);
+    } else {
+      std::ifstream in{ file_name };
+      loaded = read_matrix(in, equations, n_rows);
+    }
+    if (!loaded) {
+      std::cerr << file_name << " not loaded." << std::endl;
+      exit(1);
+    }
+    duration<double> load_time{ steady_clock::now() - start_time };
+    std::cout << "Loaded " << n_rows << " equations in " << std::fixed
+              << std::setprecision(6) << load_time.count() << " seconds\n";
+  } else {
+    std::cout << "Enter the number of variables: ";
+    std::cin >> n_rows;
+    equations = get_data(n_rows);
+  }
+
+  auto start_time = steady_clock::now();
 
   // Generate slice objects for rows in row order
   std::vector<slice> row_slices; // Objects define rows in sequence
@@ -38,6 +73,10 @@ int main()
   reduce_matrix(equations, row_slices); // Reduce to row echelon form
   auto solution = back_substitution(equations, row_slices);
 
+  duration<double> solve_time{ steady_clock::now() - start_time };
+  std::cout << "Solved " << n_rows << " equations in " << std::fixed << std::setprecision(6)
+            << solve_time.count() << " seconds\n";
+
   // Output the solution
   size_t count{}, perline{ 8 };
   std::cout << "\nSolution:\n";
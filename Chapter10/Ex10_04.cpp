@@ -6,17 +6,9 @@
 #include <iostream> // For standard streams
 #include <ratio>    // For ratio templates
 
-using namespace std::chrono;
-
-// Outputs the exact interval in seconds for a time_point<>
-template <typename TimePoint>
-void print_timepoint(const TimePoint& tp, size_t places = 0)
-{
-  auto elapsed = tp.time_since_epoch(); // duration object for the interval
+#include "Benchmark.h" // For print_timepoint()
 
-  auto seconds = duration_cast<duration<double>>(elapsed).count();
-  std::cout << std::fixed << std::setprecision(places) << seconds << " seconds\n";
-}
+using namespace std::chrono;
 
 int main()
 {
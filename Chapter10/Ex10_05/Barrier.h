@@ -0,0 +1,48 @@
+// Barrier.h for Ex10_05
+// A reusable barrier for a fixed team of threads
+// The last thread to arrive calls the completion function before any thread is
+// released, so work that must be done by one thread between phases needs no extra
+// synchronization.
+
+#ifndef BARRIER_H
+#define BARRIER_H
+
+#include <condition_variable> // For condition_variable
+#include <cstddef>            // For size_t
+#include <functional>         // For function
+#include <mutex>              // For mutex, unique_lock
+
+class Barrier {
+private:
+  std::mutex mtx;
+  std::condition_variable released;
+  size_t count{};                   // Number of threads in the team
+  size_t waiting{};                 // Number of threads that have arrived
+  size_t generation{};              // Incremented each time the barrier opens
+  std::function<void()> completion; // Called by the last thread to arrive
+
+public:
+  explicit Barrier(size_t n_threads, std::function<void()> on_completion = [] {})
+    : count(n_threads)
+    , completion(std::move(on_completion))
+  {
+  }
+
+  Barrier(const Barrier&) = delete;
+  Barrier& operator=(const Barrier&) = delete;
+
+  // Block until all threads in the team have arrived
+  void arrive_and_wait()
+  {
+    std::unique_lock<std::mutex> lock{ mtx };
+    auto current = generation;
+    if (++waiting == count) {
+      completion();
+      waiting = 0;
+      ++generation;
+      released.notify_all();
+    } else
+      released.wait(lock, [this, current] { return generation != current; });
+  }
+};
+#endif
@@ -3,14 +3,25 @@
 
 #include <algorithm> // For generate_n()
 #include <chrono>    // For clocks, duration, and time_point
+#include <cctype>    // For isdigit()
+#include <cmath>     // For abs()
+#include <fstream>   // For file streams
 #include <iomanip>   // For stream manipulators
 #include <iostream>  // For standard streams
 #include <iterator>  // For ostream iterator
-#include <string>    // For string type
+#include <optional>  // For optional type
+#include <string>    // For string type, stoul()
+#include <thread>    // For hardware_concurrency()
 #include <utility>   // For swap()
 #include <valarray>  // For valarray, slice, abs()
 #include <vector>    // For vector container
 
+#include "Benchmark.h"
+#include "Iterative_Solvers.h"
+#include "LU_Factorization.h"
+#include "Matrix_IO.h"
+#include "Sparse_Matrix.h"
+
 using std::slice;
 using std::string;
 using std::valarray;
@@ -18,45 +29,352 @@ using namespace std::chrono;
 
 // Function prototypes
 valarray<double> get_data(size_t n);
+valarray<double> generate_data(size_t n, unsigned int seed);
 void reduce_matrix(valarray<double>& equations, std::vector<slice>& row_slices);
+void reduce_matrix(valarray<double>& equations, std::vector<slice>& row_slices,
+                   size_t n_threads);
 valarray<double> back_substitution(valarray<double>& equations,
                                    const std::vector<slice>& row_slices);
+double relative_residual(const valarray<double>& equations, size_t n,
+                         const valarray<double>& x);
+Iteration_Result solve_mixed_precision(const valarray<double>& equations, size_t n,
+                                       valarray<double>& x, double tolerance,
+                                       size_t max_iterations);
+double fill_ratio(const valarray<double>& equations, size_t n);
+Sparse_Matrix generate_sparse_data(size_t n, bool symmetric, valarray<double>& rhs);
+Iteration_Result solve_sparse(const Sparse_Matrix& A, const valarray<double>& rhs,
+                              valarray<double>& solution, string& method);
+valarray<double> solve_equations(valarray<double>& equations, size_t n, double max_fill,
+                                 string& method);
+
+const double max_sparse_fill{ 0.05 };      // Maximum fill ratio for the sparse solvers
+const double refinement_tolerance{ 1e-14 }; // Residual for mixed precision solutions
+const size_t max_refinements{ 20 };         // Refinement steps before giving up
+
+// Generate slice objects for rows in row order
+std::vector<slice> make_row_slices(size_t n_rows)
+{
+  std::vector<slice> row_slices; // Objects define rows in sequence
+  size_t row_len{ n_rows + 1 };
+  std::generate_n(std::back_inserter(row_slices), n_rows,
+                  [row_len, index = size_t{}]() mutable {
+                    return slice{ row_len * index++, row_len, 1 };
+                  });
+  return row_slices;
+}
+
+// Solve the equations using slice-based row operations - equations is overwritten
+valarray<double> solve_by_elimination(valarray<double>& equations, size_t n_rows)
+{
+  auto row_slices = make_row_slices(n_rows);
+  reduce_matrix(equations, row_slices); // Reduce to row echelon form
+  return back_substitution(equations, row_slices);
+}
+
+// Solve the equations using the blocked LU factorization - equations is overwritten
+valarray<double> solve_by_lu(valarray<double>& equations, size_t n_rows)
+{
+  LU_Factorization<double> lu{ equations, n_rows };
+  return lu.solve();
+}
+
+// Time a solver applied to a copy of the equations, storing the solution
+template <typename Solver>
+duration<double> time_solver(Solver solver, const valarray<double>& equations,
+                             size_t n_rows, valarray<double>& solution)
+{
+  valarray<double> working{ equations }; // Solvers overwrite the equations
+  auto start_time = steady_clock::now();
+  solution = solver(working, n_rows);
+  return steady_clock::now() - start_time;
+}
+
+// Maximum error in a solution generated by generate_data(), which is 1, 2, ..., n
+double max_error(const valarray<double>& solution)
+{
+  double error{};
+  for (size_t i{}; i < solution.size(); ++i) {
+    auto diff = std::abs(solution[i] - (i + 1));
+    if (!(diff <= error)) // Written so a NaN is reported
+      error = diff;
+  }
+  return error;
+}
+
+// Compare the mixed precision solver with the double precision blocked LU solver
+void mixed_precision_comparison(const std::vector<size_t>& sizes)
+{
+  std::cout << std::setw(6) << "n" << std::setw(14) << "double (s)" << std::setw(12)
+            << "residual" << std::setw(14) << "mixed (s)" << std::setw(12) << "steps"
+            << std::setw(12) << "residual" << std::setw(10) << "speedup" << std::setw(12)
+            << "max error" << '\n';
+  for (auto n_rows : sizes) {
+    auto equations = generate_data(n_rows, 42u);
+    valarray<double> solution;
+    auto double_time = time_solver(solve_by_lu, equations, n_rows, solution);
+    auto double_residual = relative_residual(equations, n_rows, solution);
+
+    auto start_time = steady_clock::now();
+    auto result = solve_mixed_precision(equations, n_rows, solution, refinement_tolerance,
+                                        max_refinements);
+    duration<double> mixed_time{ steady_clock::now() - start_time };
+    std::cout << std::setw(6) << n_rows << std::fixed << std::setprecision(6)
+              << std::setw(14) << double_time.count() << std::scientific
+              << std::setprecision(2) << std::setw(12) << double_residual << std::fixed
+              << std::setprecision(6) << std::setw(14) << mixed_time.count()
+              << std::setw(12) << result.iterations << std::scientific
+              << std::setprecision(2) << std::setw(12) << result.residual << std::fixed
+              << std::setw(10) << double_time.count() / mixed_time.count()
+              << std::scientific << std::setw(12) << max_error(solution)
+              << (result.converged ? "" : "  (not converged)") << std::defaultfloat
+              << std::endl;
+  }
+}
+
+// Compare solution times for random sets of equations of each size
+void benchmark(const std::vector<size_t>& sizes, const Benchmark_Options& options)
+{
+  // Check the solvers before timing them
+  std::vector<valarray<double>> data;
+  for (auto n_rows : sizes) {
+    data.push_back(generate_data(n_rows, 42u));
+    valarray<double> solution;
+    time_solver(solve_by_elimination, data.back(), n_rows, solution);
+    auto slice_error = max_error(solution);
+    time_solver(solve_by_lu, data.back(), n_rows, solution);
+    auto lu_error = max_error(solution);
+    solve_mixed_precision(data.back(), n_rows, solution, refinement_tolerance,
+                          max_refinements);
+    std::cout << "Maximum error for " << n_rows << " equations: slices "
+              << std::scientific << std::setprecision(2) << slice_error << ", blocked LU "
+              << lu_error << ", mixed precision " << max_error(solution)
+              << std::defaultfloat << '\n';
+  }
+
+  Benchmark_Suite suite{ "Ex10_05 linear equations" };
+  valarray<double> working; // Solvers overwrite the equations so each run gets a copy
+  for (size_t i{}; i < sizes.size(); ++i) {
+    auto n_rows = sizes[i];
+    auto copy = [&working, &equations = data[i]] { working = equations; };
+    suite.add("slices n=" + std::to_string(n_rows), copy, [&working, n_rows] {
+      do_not_optimize(solve_by_elimination(working, n_rows));
+    });
+    suite.add("blocked LU n=" + std::to_string(n_rows), copy, [&working, n_rows] {
+      do_not_optimize(solve_by_lu(working, n_rows));
+    });
+    suite.add("mixed precision n=" + std::to_string(n_rows),
+              [&equations = data[i], n_rows] {
+                valarray<double> solution;
+                solve_mixed_precision(equations, n_rows, solution,
+                                      refinement_tolerance, max_refinements);
+                do_not_optimize(solution);
+              });
+  }
+  suite.run_and_report(options);
+}
 
-// Outputs the exact interval in seconds for a time_point<>
-template <typename TimePoint>
-void print_timepoint(const TimePoint& tp, size_t places = 0)
+// Time the multi-threaded elimination for 1, 2, 4, ... up to max_threads threads
+void thread_sweep(size_t max_threads, size_t n_rows)
 {
-  auto elapsed = tp.time_since_epoch(); // duration object for the interval
+  std::vector<size_t> thread_counts;
+  for (size_t n_threads{ 1 }; n_threads < max_threads; n_threads *= 2)
+    thread_counts.push_back(n_threads);
+  thread_counts.push_back(max_threads);
 
-  auto seconds = duration_cast<duration<double>>(elapsed).count();
-  std::cout << std::fixed << std::setprecision(places) << seconds << " seconds\n";
+  auto equations = generate_data(n_rows, 42u);
+  std::cout << "Solving " << n_rows << " equations\n"
+            << std::setw(8) << "threads" << std::setw(14) << "time (s)" << std::setw(10)
+            << "speedup" << std::setw(14) << "max error" << '\n';
+  double single_thread_time{};
+  for (auto n_threads : thread_counts) {
+    valarray<double> solution;
+    auto elapsed = time_solver(
+      [n_threads](valarray<double>& working, size_t n) {
+        auto row_slices = make_row_slices(n);
+        reduce_matrix(working, row_slices, n_threads);
+        return back_substitution(working, row_slices);
+      },
+      equations, n_rows, solution);
+    if (n_threads == 1)
+      single_thread_time = elapsed.count();
+    std::cout << std::setw(8) << n_threads << std::fixed << std::setprecision(6)
+              << std::setw(14) << elapsed.count() << std::setprecision(2)
+              << std::setw(10) << single_thread_time / elapsed.count() << std::scientific
+              << std::setw(14) << max_error(solution) << std::defaultfloat << std::endl;
+  }
 }
 
-int main()
+// Solve symmetric and nonsymmetric sparse sets of n equations
+void sparse_benchmark(size_t n_rows)
 {
+  for (bool symmetric : { true, false }) {
+    valarray<double> rhs, solution;
+    auto start_time = steady_clock::now();
+    auto A = generate_sparse_data(n_rows, symmetric, rhs);
+    duration<double> build_time{ steady_clock::now() - start_time };
+
+    string method;
+    start_time = steady_clock::now();
+    auto result = solve_sparse(A, rhs, solution, method);
+    duration<double> solve_time{ steady_clock::now() - start_time };
+
+    std::cout << (symmetric ? "Symmetric" : "Nonsymmetric") << " system of " << n_rows
+              << " equations with " << A.nonzeros() << " nonzeros ("
+              << A.memory() / (1024 * 1024) << " MB), built in " << std::fixed
+              << std::setprecision(3) << build_time.count() << " seconds\n  " << method
+              << ": " << result.iterations << " iterations, residual " << std::scientific
+              << std::setprecision(2) << result.residual << ", max error "
+              << max_error(solution) << (result.converged ? "" : " (not converged)")
+              << ", " << std::fixed << std::setprecision(3) << solve_time.count()
+              << " seconds" << std::endl;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  // Ex10_05 --sparse [n] solves sparse sets of n equations iteratively
+  if (argc > 1 && string{ argv[1] } == "--sparse") {
+    sparse_benchmark(argc > 2 ? std::stoul(argv[2]) : 1'000'000);
+    return 0;
+  }
+
+  // Ex10_05 --threads N [n] times the multi-threaded elimination with up to N threads
+  if (argc > 1 && string{ argv[1] } == "--threads") {
+    size_t max_threads{ argc > 2 ? std::stoul(argv[2])
+                                 : std::max(1u, std::thread::hardware_concurrency()) };
+    size_t n_rows{ argc > 3 ? std::stoul(argv[3]) : 2000 };
+    thread_sweep(std::max(max_threads, size_t{ 1 }), n_rows);
+    return 0;
+  }
+
+  // Ex10_05 --mixed [n...] compares mixed precision and double precision solutions
+  if (argc > 1 && string{ argv[1] } == "--mixed") {
+    std::vector<size_t> sizes;
+    for (int i{ 2 }; i < argc; ++i)
+      sizes.push_back(std::stoul(argv[i]));
+    if (sizes.empty())
+      sizes = { 500, 1000, 2000, 4000 };
+    mixed_precision_comparison(sizes);
+    return 0;
+  }
+
+  // Ex10_05 --benchmark [n...] [options] compares the solvers for random sets of
+  // equations - the options are those accepted by parse_benchmark_options()
+  if (argc > 1 && string{ argv[1] } == "--benchmark") {
+    std::vector<size_t> sizes;
+    int arg{ 2 };
+    for (; arg < argc && std::isdigit(static_cast<unsigned char>(argv[arg][0])); ++arg)
+      sizes.push_back(std::stoul(argv[arg]));
+    if (sizes.empty())
+      sizes = { 500, 1000, 2000, 4000 };
+    Benchmark_Options options;
+    options.samples = 10;
+    if (!parse_benchmark_options(argc, argv, arg, options)) {
+      std::cerr << "Usage: Ex10_05 --benchmark [n...] [--samples N] [--warmup N] "
+                   "[--max-seconds S] [--filter TEXT] [--json FILE] [--no-pin]"
+                << std::endl;
+      exit(1);
+    }
+    benchmark(sizes, options);
+    return 0;
+  }
+
+  // Ex10_05 --write text|binary n file writes a random set of n equations to a file
+  if (argc > 1 && string{ argv[1] } == "--write") {
+    if (argc < 5) {
+      std::cerr << "Usage: Ex10_05 --write text|binary n file" << std::endl;
+      exit(1);
+    }
+    string format{ argv[2] }, file_name{ argv[4] };
+    size_t n_rows{ std::stoul(argv[3]) };
+    auto equations = generate_data(n_rows, 42u);
+    if (!(format == "binary" ? write_binary_matrix(file_name, equations, n_rows)
+                             : write_text_matrix(file_name, equations, n_rows))) {
+      std::cerr << file_name << " not written." << std::endl;
+      exit(1);
+    }
+    return 0;
+  }
+
   size_t n_rows{};
-  std::cout << "Enter the number of variables: ";
-  std::cin >> n_rows;
-  auto equations = get_data(n_rows);
+  valarray<double> equations;          // Equations for the slice-based solver
+  valarray<double> lu_equations;       // Copy for the blocked LU solver...
+  double* lu_data{};                   // ...or the mapped binary file
+  std::optional<Binary_Matrix> mapped; // Binary file mapped into memory
 
-  auto start_time = steady_clock::now(); // time_point object
+  // Ex10_05 --load stream|fast|binary file reads the equations from a file
+  if (argc > 1 && string{ argv[1] } == "--load") {
+    if (argc < 4) {
+      std::cerr << "Usage: Ex10_05 --load stream|fast|binary file" << std::endl;
+      exit(1);
+    }
+    string loader{ argv[2] }, file_name{ argv[3] };
+    bool loaded{};
+    auto start_time = steady_clock::now();
+    if (loader == "binary") { // Map the file and use it in place
+      mapped.emplace(file_name);
+      if ((loaded = static_cast<bool>(*mapped))) {
+        n_rows = mapped->unknowns();
+        lu_data = mapped->data();
+      }
+    } else if (loader == "fast") { // Map the file and parse it with from_chars()
+      loaded = load_text_matrix(file_name, equations, n_rows);
+    } else { // Read the file with stream extraction
+      std::ifstream in{ file_name };
+      loaded = read_matrix(in, equations, n_rows);
+    }
+    if (!loaded) {
+      std::cerr << file_name << " not loaded." << std::endl;
+      exit(1);
+    }
+    auto end_time = steady_clock::now();
+    auto elapsed = end_time - start_time.time_since_epoch();
+    std::cout << "Time to load " << n_rows << " equations using the " << loader
+              << " loader is ";
+    print_timepoint(elapsed, 9);
+    if (mapped) // The slice-based solver needs a valarray
+      equations = mapped->values();
+  } else {
+    std::cout << "Enter the number of variables: ";
+    std::cin >> n_rows;
+    equations = get_data(n_rows);
+  }
+  if (!lu_data) {
+    lu_equations = equations;
+    lu_data = &lu_equations[0];
+  }
+  valarray<double> sparse_equations; // Copy for the solver driver if mostly zeros
+  if (fill_ratio(equations, n_rows) <= max_sparse_fill)
+    sparse_equations = equations;
 
-  // Generate slice objects for rows in row order
-  std::vector<slice> row_slices; // Objects define rows in sequence
-  size_t row_len{ n_rows + 1 };
-  std::generate_n(std::back_inserter(row_slices), n_rows, [row_len]() {
-    static size_t index{};
-    return slice{ row_len * index++, row_len, 1 };
-  });
+  auto start_time = steady_clock::now(); // time_point object
 
-  reduce_matrix(equations, row_slices); // Reduce to row echelon form
-  auto solution = back_substitution(equations, row_slices);
+  auto solution = solve_by_elimination(equations, n_rows);
 
   auto end_time = steady_clock::now(); // time_point object
   auto elapsed = end_time - start_time.time_since_epoch();
   std::cout << "Time to solve " << n_rows << " equations is ";
   print_timepoint(elapsed, 9);
 
+  start_time = steady_clock::now();
+  LU_Factorization<double> lu{ lu_data, n_rows };
+  lu.solve();
+  end_time = steady_clock::now();
+  elapsed = end_time - start_time.time_since_epoch();
+  std::cout << "Time to solve " << n_rows << " equations by blocked LU is ";
+  print_timepoint(elapsed, 9);
+
+  // Let the driver choose a solver when the coefficients are mostly zero
+  if (sparse_equations.size()) {
+    string method;
+    start_time = steady_clock::now();
+    solve_equations(sparse_equations, n_rows, max_sparse_fill, method);
+    end_time = steady_clock::now();
+    elapsed = end_time - start_time.time_since_epoch();
+    std::cout << "Time to solve " << n_rows << " sparse equations by " << method << " is ";
+    print_timepoint(elapsed, 9);
+  }
+
   // Output the solution
   size_t count{}, perline{ 8 };
   std::cout << "\nSolution:\n";
@@ -0,0 +1,153 @@
+// Iterative_Solvers.h for Ex10_05
+// Preconditioned Conjugate Gradient and BiCGSTAB solvers for sparse equations
+// Conjugate Gradient requires a symmetric positive definite matrix. BiCGSTAB works
+// for general nonsymmetric matrices at roughly twice the cost per iteration. Both use
+// a Jacobi preconditioner, which scales the residual by the inverse of the diagonal.
+
+#ifndef ITERATIVE_SOLVERS_H
+#define ITERATIVE_SOLVERS_H
+
+#include <cmath>    // For sqrt()
+#include <valarray> // For valarray
+
+#include "Sparse_Matrix.h"
+
+// Outcome of an iterative solution
+struct Iteration_Result {
+  size_t iterations{}; // Number of iterations performed
+  double residual{};   // Final value of |b - A*x| / |b|
+  bool converged{};    // true if residual is within the tolerance
+};
+
+// Jacobi preconditioner - M is the inverse of the diagonal of A
+class Jacobi_Preconditioner {
+private:
+  std::valarray<double> inverse_diagonal;
+
+public:
+  explicit Jacobi_Preconditioner(const Sparse_Matrix& A)
+    : inverse_diagonal(A.diagonal())
+  {
+    for (auto& d : inverse_diagonal)
+      d = d != 0.0 ? 1.0 / d : 1.0; // Leave rows with a zero diagonal unscaled
+  }
+
+  // Compute z = M*r
+  void apply(const std::valarray<double>& r, std::valarray<double>& z) const
+  {
+    z = inverse_diagonal * r;
+  }
+};
+
+inline double dot(const std::valarray<double>& a, const std::valarray<double>& b)
+{
+  double sum{};
+  for (size_t i{}; i < a.size(); ++i)
+    sum += a[i] * b[i];
+  return sum;
+}
+
+inline double norm(const std::valarray<double>& a)
+{
+  return std::sqrt(dot(a, a));
+}
+
+// Solve A*x = b by the preconditioned Conjugate Gradient method
+// x contains the initial guess and is replaced by the solution
+inline Iteration_Result conjugate_gradient(const Sparse_Matrix& A,
+                                           const std::valarray<double>& b,
+                                           std::valarray<double>& x,
+                                           double tolerance = 1e-10,
+                                           size_t max_iterations = 10000)
+{
+  Iteration_Result result;
+  Jacobi_Preconditioner M{ A };
+  size_t n{ b.size() };
+  double b_norm{ norm(b) };
+  if (b_norm == 0.0) {
+    x = 0.0;
+    result.converged = true;
+    return result;
+  }
+
+  std::valarray<double> r(n), z(n), p(n), Ap(n);
+  A.multiply(x, Ap);
+  r = b - Ap;
+  M.apply(r, z);
+  p = z;
+  double rz{ dot(r, z) };
+  result.residual = norm(r) / b_norm;
+
+  while (result.residual > tolerance && result.iterations < max_iterations) {
+    ++result.iterations;
+    A.multiply(p, Ap);
+    double alpha{ rz / dot(p, Ap) };
+    x += alpha * p;
+    r -= alpha * Ap;
+    result.residual = norm(r) / b_norm;
+    if (result.residual <= tolerance)
+      break;
+    M.apply(r, z);
+    double rz_next{ dot(r, z) };
+    p = z + (rz_next / rz) * p;
+    rz = rz_next;
+  }
+  result.converged = result.residual <= tolerance;
+  return result;
+}
+
+// Solve A*x = b by the preconditioned BiCGSTAB method
+// x contains the initial guess and is replaced by the solution
+inline Iteration_Result bicgstab(const Sparse_Matrix& A, const std::valarray<double>& b,
+                                 std::valarray<double>& x, double tolerance = 1e-10,
+                                 size_t max_iterations = 10000)
+{
+  Iteration_Result result;
+  Jacobi_Preconditioner M{ A };
+  size_t n{ b.size() };
+  double b_norm{ norm(b) };
+  if (b_norm == 0.0) {
+    x = 0.0;
+    result.converged = true;
+    return result;
+  }
+
+  std::valarray<double> r(n), r0(n), p(n), v(n), s(n), t(n), y(n), z(n);
+  A.multiply(x, v);
+  r = b - v;
+  r0 = r; // Shadow residual
+  p = 0.0;
+  v = 0.0;
+  double rho{ 1.0 }, alpha{ 1.0 }, omega{ 1.0 };
+  result.residual = norm(r) / b_norm;
+
+  while (result.residual > tolerance && result.iterations < max_iterations) {
+    ++result.iterations;
+    double rho_next{ dot(r0, r) };
+    if (rho_next == 0.0) // Breakdown - the method cannot continue
+      break;
+    double beta{ (rho_next / rho) * (alpha / omega) };
+    rho = rho_next;
+    p = r + beta * (p - omega * v);
+    M.apply(p, y);
+    A.multiply(y, v);
+    alpha = rho / dot(r0, v);
+    s = r - alpha * v;
+    if (norm(s) / b_norm <= tolerance) { // Converged at the half step
+      x += alpha * y;
+      result.residual = norm(s) / b_norm;
+      break;
+    }
+    M.apply(s, z);
+    A.multiply(z, t);
+    omega = dot(t, s) / dot(t, t);
+    x += alpha * y + omega * z;
+    r = s - omega * t;
+    result.residual = norm(r) / b_norm;
+    if (omega == 0.0) // Breakdown
+      break;
+  }
+  result.converged = result.residual <= tolerance;
+  return result;
+}
+#endif
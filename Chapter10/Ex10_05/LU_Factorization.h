@@ -0,0 +1,179 @@
+// LU_Factorization.h for Ex10_05
+// Cache-blocked LU factorization with partial pivoting
+// The factorization works in place on the equations array used by gaussian.cpp, which
+// stores n rows of n+1 elements with the right-hand side in the last column. The
+// array can be a valarray or any other contiguous storage such as a mapped file. The
+// coefficients are overwritten by the L and U factors, so once the matrix has been
+// factored, any number of right-hand sides can be solved without factoring again.
+
+#ifndef LU_FACTORIZATION_H
+#define LU_FACTORIZATION_H
+
+#include <algorithm> // For min(), swap_ranges()
+#include <cmath>     // For abs()
+#include <cstdlib>   // For exit()
+#include <iostream>  // For standard streams
+#include <utility>   // For swap()
+#include <valarray>  // For valarray
+#include <vector>    // For vector container
+
+template <typename T>
+class LU_Factorization {
+private:
+  T* equations{};              // n rows of n+1 elements - factored in place
+  size_t n{};                  // Number of unknowns
+  size_t row_len{};            // Row length = n+1
+  size_t block{};              // Block size for panels and tiles
+  std::vector<size_t> pivots;  // pivots[k] is the row swapped with row k at step k
+
+  T* row(size_t i) { return &equations[i * row_len]; }
+  const T* row(size_t i) const { return &equations[i * row_len]; }
+
+  // Find the best pivot in column k, swap it into row k and record the swap
+  void set_pivot(size_t k)
+  {
+    size_t max_row{ k };
+    T max_value{ std::abs(row(k)[k]) };
+    for (size_t i{ k + 1 }; i < n; ++i) {
+      if (max_value < std::abs(row(i)[k])) {
+        max_value = std::abs(row(i)[k]);
+        max_row = i;
+      }
+    }
+    if (max_value == T{}) { // When pivot is 0, matrix is singular
+      std::cerr << "No solution. Ending program." << std::endl;
+      std::exit(1);
+    }
+    pivots[k] = max_row;
+    if (max_row != k) // Swap the coefficients - the rhs column is left alone
+      std::swap_ranges(row(k), row(k) + n, row(max_row));
+  }
+
+  // Factor the panel of columns [k0, k0+kb) for all rows from k0 down
+  void factor_panel(size_t k0, size_t kb)
+  {
+    size_t k_end{ k0 + kb };
+    for (size_t k{ k0 }; k < k_end; ++k) {
+      set_pivot(k);
+      const T* pivot_row{ row(k) };
+      T pivot{ pivot_row[k] };
+      for (size_t i{ k + 1 }; i < n; ++i) {
+        T* r{ row(i) };
+        T multiplier{ r[k] /= pivot }; // Store the L factor in place
+        for (size_t j{ k + 1 }; j < k_end; ++j)
+          r[j] -= multiplier * pivot_row[j];
+      }
+    }
+  }
+
+  // Compute the block row of U to the right of the panel:
+  // U12 = inverse(L11) * A12, where L11 is unit lower triangular
+  void solve_block_row(size_t k0, size_t kb)
+  {
+    size_t k_end{ k0 + kb };
+    for (size_t i{ k0 + 1 }; i < k_end; ++i) {
+      T* r{ row(i) };
+      for (size_t k{ k0 }; k < i; ++k) {
+        T multiplier{ r[k] };
+        const T* u{ row(k) };
+        for (size_t j{ k_end }; j < n; ++j)
+          r[j] -= multiplier * u[j];
+      }
+    }
+  }
+
+  // Update the trailing submatrix tile by tile: A22 -= L21 * U12
+  // Each column tile of U12 is kb rows by block columns, so it stays in cache while
+  // it is applied to every row below the panel.
+  void update_trailing(size_t k0, size_t kb)
+  {
+    size_t k_end{ k0 + kb };
+    size_t col_block{ 4 * block };
+    for (size_t j0{ k_end }; j0 < n; j0 += col_block) {
+      size_t j_end{ std::min(j0 + col_block, n) };
+      for (size_t i{ k_end }; i < n; ++i) {
+        T* r{ row(i) };
+        size_t k{ k0 };
+        for (; k + 4 <= k_end; k += 4) { // Four rows of U12 per pass over r
+          T m0{ r[k] }, m1{ r[k + 1] }, m2{ r[k + 2] }, m3{ r[k + 3] };
+          const T *u0{ row(k) }, *u1{ row(k + 1) }, *u2{ row(k + 2) }, *u3{ row(k + 3) };
+          for (size_t j{ j0 }; j < j_end; ++j)
+            r[j] -= m0 * u0[j] + m1 * u1[j] + m2 * u2[j] + m3 * u3[j];
+        }
+        for (; k < k_end; ++k) {
+          T multiplier{ r[k] };
+          const T* u{ row(k) };
+          for (size_t j{ j0 }; j < j_end; ++j)
+            r[j] -= multiplier * u[j];
+        }
+      }
+    }
+  }
+
+public:
+  // Factor the coefficients in equations for n unknowns
+  // The block size should be chosen so that a block x 4*block tile fits in L2 cache
+  LU_Factorization(T* eqns, size_t n_rows, size_t block_size = 64)
+    : equations(eqns)
+    , n(n_rows)
+    , row_len(n_rows + 1)
+    , block(block_size ? block_size : 1)
+    , pivots(n_rows)
+  {
+    for (size_t k0{}; k0 < n; k0 += block) {
+      size_t kb{ std::min(block, n - k0) };
+      factor_panel(k0, kb);
+      solve_block_row(k0, kb);
+      update_trailing(k0, kb);
+    }
+  }
+
+  LU_Factorization(std::valarray<T>& eqns, size_t n_rows, size_t block_size = 64)
+    : LU_Factorization(&eqns[0], n_rows, block_size)
+  {
+  }
+
+  size_t size() const { return n; }
+
+  // Solve for a right-hand side in place - rhs must have n elements
+  void solve(T* rhs) const
+  {
+    for (size_t k{}; k < n; ++k) // Apply the row interchanges
+      std::swap(rhs[k], rhs[pivots[k]]);
+
+    for (size_t i{ 1 }; i < n; ++i) { // Forward substitution with L
+      const T* r{ row(i) };
+      T sum{ rhs[i] };
+      for (size_t j{}; j < i; ++j)
+        sum -= r[j] * rhs[j];
+      rhs[i] = sum;
+    }
+
+    for (size_t i{ n }; i-- > 0;) { // Back substitution with U
+      const T* r{ row(i) };
+      T sum{ rhs[i] };
+      for (size_t j{ i + 1 }; j < n; ++j)
+        sum -= r[j] * rhs[j];
+      rhs[i] = sum / r[i];
+    }
+  }
+
+  // Solve for a right-hand side and return the solution
+  std::valarray<T> solve(const std::valarray<T>& rhs) const
+  {
+    std::valarray<T> x{ rhs };
+    solve(&x[0]);
+    return x;
+  }
+
+  // Solve for the right-hand side stored in the last column of equations
+  std::valarray<T> solve() const
+  {
+    std::valarray<T> x(n);
+    for (size_t i{}; i < n; ++i)
+      x[i] = row(i)[n];
+    solve(&x[0]);
+    return x;
+  }
+};
+#endif
@@ -0,0 +1,119 @@
+// Sparse_Matrix.h for Ex10_05
+// A matrix stored in compressed sparse row (CSR) form
+// Only the nonzero elements are stored. The values and column indexes for the nonzero
+// elements are stored row by row, and row_starts[i] is the index of the first element
+// in row i, so row i occupies [row_starts[i], row_starts[i+1]). The memory required is
+// proportional to the number of nonzero elements.
+
+#ifndef SPARSE_MATRIX_H
+#define SPARSE_MATRIX_H
+
+#include <algorithm> // For lower_bound()
+#include <cstddef>   // For size_t
+#include <valarray>  // For valarray
+#include <vector>    // For vector container
+
+class Sparse_Matrix {
+private:
+  size_t n_rows{};
+  size_t n_cols{};
+  std::vector<size_t> row_starts{ 0 }; // Index of the first element in each row
+  std::vector<size_t> columns;         // Column index for each element
+  std::vector<double> values;          // Value of each element
+
+public:
+  Sparse_Matrix(size_t rows, size_t cols)
+    : n_cols(cols)
+  {
+    row_starts.reserve(rows + 1);
+  }
+
+  // Reserve memory for the given number of nonzero elements
+  void reserve(size_t nonzeros)
+  {
+    columns.reserve(nonzeros);
+    values.reserve(nonzeros);
+  }
+
+  // Append an element to the current row - columns must be in ascending order
+  void append(size_t col, double value)
+  {
+    columns.push_back(col);
+    values.push_back(value);
+  }
+
+  // End the current row and start the next
+  void end_row()
+  {
+    row_starts.push_back(columns.size());
+    ++n_rows;
+  }
+
+  size_t rows() const { return n_rows; }
+  size_t cols() const { return n_cols; }
+  size_t nonzeros() const { return values.size(); }
+
+  // Proportion of the elements that are nonzero
+  double fill_ratio() const
+  {
+    return n_rows && n_cols ? static_cast<double>(nonzeros()) / n_rows / n_cols : 0.0;
+  }
+
+  // Bytes used to store the matrix
+  size_t memory() const
+  {
+    return row_starts.capacity() * sizeof(size_t) + columns.capacity() * sizeof(size_t)
+      + values.capacity() * sizeof(double);
+  }
+
+  // Return element (row, col) - zero if it is not stored
+  double operator()(size_t row, size_t col) const
+  {
+    auto first = std::begin(columns) + row_starts[row];
+    auto last = std::begin(columns) + row_starts[row + 1];
+    auto iter = std::lower_bound(first, last, col);
+    return iter != last && *iter == col ? values[iter - std::begin(columns)] : 0.0;
+  }
+
+  // Return the elements on the diagonal
+  std::valarray<double> diagonal() const
+  {
+    std::valarray<double> diag(n_rows);
+    for (size_t row{}; row < n_rows; ++row)
+      diag[row] = (*this)(row, row);
+    return diag;
+  }
+
+  // Check whether the matrix is equal to its transpose
+  bool is_symmetric() const
+  {
+    if (n_rows != n_cols)
+      return false;
+    for (size_t row{}; row < n_rows; ++row) {
+      for (size_t i{ row_starts[row] }; i < row_starts[row + 1]; ++i) {
+        if (columns[i] > row && (*this)(columns[i], row) != values[i])
+          return false;
+      }
+    }
+    return true;
+  }
+
+  // Compute y = A*x
+  void multiply(const std::valarray<double>& x, std::valarray<double>& y) const
+  {
+    for (size_t row{}; row < n_rows; ++row) {
+      double sum{};
+      for (size_t i{ row_starts[row] }; i < row_starts[row + 1]; ++i)
+        sum += values[i] * x[columns[i]];
+      y[row] = sum;
+    }
+  }
+
+  std::valarray<double> operator*(const std::valarray<double>& x) const
+  {
+    std::valarray<double> y(n_rows);
+    multiply(x, y);
+    return y;
+  }
+};
+#endif
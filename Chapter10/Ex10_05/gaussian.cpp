@@ -2,13 +2,20 @@
 // Functions to implement Gaussian elimination
 
 #include <algorithm> // For copy_n()
+#include <cmath>     // For sqrt()
 #include <iomanip>   // For stream manipulators
 #include <iostream>  // For standard streams
 #include <iterator>  // For ostream iterator
+#include <random>    // For distributions and random number generator
+#include <thread>    // For thread class
 #include <utility>   // For swap()
 #include <valarray>  // For valarray, slice, abs()
 #include <vector>    // For vector container
 
+#include "Barrier.h"
+#include "Iterative_Solvers.h"
+#include "LU_Factorization.h"
+
 using std::slice;
 using std::valarray;
 
@@ -23,6 +30,25 @@ valarray<double> get_data(size_t n)
   return equations;
 }
 
+// Generate the data for n equations in n unknowns with random coefficients
+// The rhs values are chosen so the solution is x1 = 1, x2 = 2, ..., xn = n
+valarray<double> generate_data(size_t n, unsigned int seed)
+{
+  std::mt19937 rng{ seed };                                  // Mersenne twister generator
+  std::uniform_real_distribution<double> coeffs{ -1.0, 1.0 }; // Coefficient range
+  size_t row_len{ n + 1 };
+  valarray<double> equations(n * row_len); // n rows of n+1 elements
+  for (size_t row{}; row < n; ++row) {
+    double rhs{};
+    for (size_t col{}; col < n; ++col) {
+      auto& coeff = equations[row * row_len + col] = coeffs(rng);
+      rhs += coeff * (col + 1);
+    }
+    equations[row * row_len + n] = rhs;
+  }
+  return equations;
+}
+
 // Selects the best pivot in row n (rows indexed from 0)
 void set_pivot(const valarray<double>& equations, std::vector<slice>& row_slices,
                size_t n)
@@ -75,6 +101,57 @@ void reduce_matrix(valarray<double>& equations, std::vector<slice>& row_slices)
   }
 }
 
+// Reduce the equations matrix to row echelon form using n_threads threads
+// The updates to the rows following the pivot row are independent, so they are shared
+// between the threads. The last thread to reach the barrier at the end of each step
+// selects the pivot for the next step while the others wait.
+void reduce_matrix(valarray<double>& equations, std::vector<slice>& row_slices,
+                   size_t n_threads)
+{
+  size_t n_rows{ row_slices.size() }; // Number of rows
+  if (n_rows < 2)
+    return;
+  size_t row_len{ n_rows + 1 }; // Row length
+  n_threads = std::max(n_threads, size_t{ 1 });
+
+  size_t row{};                        // Current pivot row
+  valarray<double> pivot_row(row_len); // Pivot row divided by the pivot
+  auto next_pivot = [&] {
+    set_pivot(equations, row_slices, row); // Find best pivot
+    pivot_row = equations[row_slices[row]];
+    auto pivot = pivot_row[row];
+    pivot_row /= pivot; // Divide pivot row by pivot
+  };
+  next_pivot();
+  Barrier barrier{ n_threads, [&] {
+                    if (++row < n_rows - 1)
+                      next_pivot();
+                  } };
+
+  auto update_rows = [&](size_t id) {
+    for (size_t step{}; step < n_rows - 1; ++step) {
+      // This thread's share of the rows following the pivot row
+      size_t first{ step + 1 }, rows_left{ n_rows - first };
+      size_t begin{ first + rows_left * id / n_threads };
+      size_t end{ first + rows_left * (id + 1) / n_threads };
+      for (size_t next_row{ begin }; next_row < end; ++next_row) {
+        double* elements{ &equations[row_slices[next_row].start()] };
+        double multiplier{ elements[step] };
+        for (size_t col{ step }; col < row_len; ++col)
+          elements[col] -= multiplier * pivot_row[col];
+      }
+      barrier.arrive_and_wait();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (size_t id{ 1 }; id < n_threads; ++id)
+    threads.emplace_back(update_rows, id);
+  update_rows(0); // This thread is a member of the team too
+  for (auto& t : threads)
+    t.join();
+}
+
 // Perform back substitution and return the solution
 valarray<double> back_substitution(valarray<double>& equations,
                                    const std::vector<slice>& row_slices)
@@ -97,3 +174,72 @@ valarray<double> back_substitution(valarray<double>& equations,
   }
   return results;
 }
+
+// Compute |b - A*x| / |b| for the equations and a solution x
+double relative_residual(const valarray<double>& equations, size_t n,
+                         const valarray<double>& x)
+{
+  size_t row_len{ n + 1 };
+  double residual_sq{}, rhs_sq{};
+  for (size_t row{}; row < n; ++row) {
+    const double* coeffs{ &equations[row * row_len] };
+    double r{ coeffs[n] };
+    for (size_t col{}; col < n; ++col)
+      r -= coeffs[col] * x[col];
+    residual_sq += r * r;
+    rhs_sq += coeffs[n] * coeffs[n];
+  }
+  return rhs_sq > 0.0 ? std::sqrt(residual_sq / rhs_sq) : std::sqrt(residual_sq);
+}
+
+// Solve the equations by factoring in float and refining the solution in double
+// Factoring in float halves the memory traffic and doubles the elements per SIMD
+// operation. Each refinement step computes the residual r = b - A*x in double from the
+// original equations, solves A*d = r with the float factors, and adds d to x. This
+// converges to double accuracy when the matrix is not too badly conditioned; if the
+// residual stops falling, refinement stops and the result is marked as not converged.
+// The equations are not modified.
+Iteration_Result solve_mixed_precision(const valarray<double>& equations, size_t n,
+                                       valarray<double>& x, double tolerance,
+                                       size_t max_iterations)
+{
+  size_t row_len{ n + 1 };
+  valarray<float> low(n * row_len); // Single precision copy of the equations
+  for (size_t i{}; i < low.size(); ++i)
+    low[i] = static_cast<float>(equations[i]);
+  LU_Factorization<float> lu{ low, n };
+
+  Iteration_Result result;
+  x.resize(n, 0.0);
+  valarray<double> r(n); // Residual in double
+  valarray<float> d(n);  // Correction in float
+  double rhs_norm{};
+  for (size_t row{}; row < n; ++row)
+    rhs_norm += equations[row * row_len + n] * equations[row * row_len + n];
+  rhs_norm = rhs_norm > 0.0 ? std::sqrt(rhs_norm) : 1.0;
+
+  double previous{ 1e300 };
+  while (true) {
+    for (size_t row{}; row < n; ++row) { // r = b - A*x
+      const double* coeffs{ &equations[row * row_len] };
+      double sum{ coeffs[n] };
+      for (size_t col{}; col < n; ++col)
+        sum -= coeffs[col] * x[col];
+      r[row] = sum;
+    }
+    result.residual = norm(r) / rhs_norm;
+    if ((result.converged = result.residual <= tolerance))
+      break;
+    if (result.iterations == max_iterations || !(result.residual < 0.5 * previous))
+      break; // Out of iterations, or no longer improving
+    previous = result.residual;
+
+    for (size_t i{}; i < n; ++i)
+      d[i] = static_cast<float>(r[i]);
+    lu.solve(&d[0]);
+    for (size_t i{}; i < n; ++i)
+      x[i] += d[i];
+    ++result.iterations;
+  }
+  return result;
+}
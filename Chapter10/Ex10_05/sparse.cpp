@@ -0,0 +1,113 @@
+// sparse.cpp
+// Functions to create sparse equations and to choose between sparse and dense solvers
+
+#include <cmath>    // For sqrt()
+#include <string>   // For string class
+#include <valarray> // For valarray
+
+#include "Iterative_Solvers.h"
+#include "LU_Factorization.h"
+#include "Sparse_Matrix.h"
+
+using std::string;
+using std::valarray;
+
+// Proportion of the coefficients in n rows of n+1 elements that are nonzero
+double fill_ratio(const valarray<double>& equations, size_t n)
+{
+  size_t nonzeros{};
+  for (size_t row{}; row < n; ++row)
+    for (size_t col{}; col < n; ++col)
+      nonzeros += equations[row * (n + 1) + col] != 0.0;
+  return n ? static_cast<double>(nonzeros) / n / n : 0.0;
+}
+
+// Create a sparse matrix from the coefficients in n rows of n+1 elements
+// The right-hand sides are stored in rhs
+Sparse_Matrix to_sparse(const valarray<double>& equations, size_t n, valarray<double>& rhs)
+{
+  Sparse_Matrix A{ n, n };
+  rhs.resize(n);
+  for (size_t row{}; row < n; ++row) {
+    const double* elements{ &equations[row * (n + 1)] };
+    for (size_t col{}; col < n; ++col)
+      if (elements[col] != 0.0)
+        A.append(col, elements[col]);
+    A.end_row();
+    rhs[row] = elements[n];
+  }
+  return A;
+}
+
+// Generate sparse equations for a diffusion problem on a grid of n points
+// Each unknown is coupled to its four neighbors on a square grid, so there are at most
+// five nonzero elements in each row. When symmetric is false, a convection term makes
+// the matrix nonsymmetric. The rhs values are chosen so the solution is 1, 2, ..., n.
+Sparse_Matrix generate_sparse_data(size_t n, bool symmetric, valarray<double>& rhs)
+{
+  size_t side{ static_cast<size_t>(std::sqrt(static_cast<double>(n))) };
+  while (side * side < n)
+    ++side;
+  double convection{ symmetric ? 0.0 : 0.1 }; // Skews the east and west couplings
+  double reaction{ 0.01 };                    // Keeps the matrix well conditioned
+
+  Sparse_Matrix A{ n, n };
+  A.reserve(5 * n);
+  for (size_t row{}; row < n; ++row) { // Columns must be appended in ascending order
+    size_t x{ row % side };
+    if (row >= side)
+      A.append(row - side, -1.0); // North
+    if (x > 0)
+      A.append(row - 1, -1.0 - convection); // West
+    A.append(row, 4.0 + reaction);
+    if (x + 1 < side && row + 1 < n)
+      A.append(row + 1, -1.0 + convection); // East
+    if (row + side < n)
+      A.append(row + side, -1.0); // South
+    A.end_row();
+  }
+
+  valarray<double> solution(n);
+  for (size_t i{}; i < n; ++i)
+    solution[i] = i + 1.0;
+  rhs = A * solution;
+  return A;
+}
+
+// Solve sparse equations by Conjugate Gradient if the matrix is symmetric with a
+// positive diagonal, otherwise by BiCGSTAB
+// If Conjugate Gradient fails to converge, the matrix cannot be positive definite, so
+// BiCGSTAB is tried. method records the solver that produced the result.
+Iteration_Result solve_sparse(const Sparse_Matrix& A, const valarray<double>& rhs,
+                              valarray<double>& solution, string& method)
+{
+  solution.resize(rhs.size());
+  solution = 0.0;
+  if (A.is_symmetric() && A.diagonal().min() > 0.0) {
+    method = "Conjugate Gradient";
+    auto result = conjugate_gradient(A, rhs, solution);
+    if (result.converged)
+      return result;
+    solution = 0.0;
+  }
+  method = "BiCGSTAB";
+  return bicgstab(A, rhs, solution);
+}
+
+// Solve n equations stored as n rows of n+1 elements
+// When the proportion of nonzero coefficients is no more than max_fill, the equations
+// are converted to CSR form and solved iteratively. Otherwise, or if the iteration does
+// not converge, the blocked LU solver is used. equations may be overwritten.
+valarray<double> solve_equations(valarray<double>& equations, size_t n, double max_fill,
+                                 string& method)
+{
+  if (fill_ratio(equations, n) <= max_fill) {
+    valarray<double> rhs, solution;
+    auto A = to_sparse(equations, n, rhs);
+    if (solve_sparse(A, rhs, solution, method).converged)
+      return solution;
+  }
+  method = "blocked LU";
+  LU_Factorization<double> lu{ equations, n };
+  return lu.solve();
+}
@@ -0,0 +1,142 @@
+// Escape_Time.h for Ex10_06
+// Escape-time kernels for Julia and Mandelbrot sets
+// Each kernel iterates z = z*z + c for a run of pixels and records how many iterations
+// each pixel survives with |z| <= 2. Once |z| exceeds 2, z grows without limit, so the
+// iteration stops for that pixel; a pixel that survives max_iterations is in the set.
+// The SIMD kernels process 4 (AVX2) or 8 (AVX-512) pixels at once with a mask of the
+// pixels still iterating, and stop when every pixel in the group has escaped. The
+// kernel to use is selected at run time from the instructions the processor supports.
+
+#ifndef ESCAPE_TIME_H
+#define ESCAPE_TIME_H
+
+#include <cstddef> // For size_t
+#include <string>  // For string class
+#include <vector>  // For vector container
+
+#if (defined(__GNUC__) || defined(__clang__))                                           \
+  && (defined(__x86_64__) || defined(__i386__))
+#define ESCAPE_TIME_X86 1
+#include <immintrin.h> // For AVX2 and AVX-512 intrinsics
+#endif
+
+// Computes counts[i] for the pixels with starting values z_re[i] + i*z_im[i] and
+// constants c_re[i] + i*c_im[i], for i from 0 to n-1
+using Escape_Kernel = void (*)(const double* z_re, const double* z_im, const double* c_re,
+                               const double* c_im, size_t n, unsigned max_iterations,
+                               unsigned* counts);
+
+// Iterate one pixel at a time
+inline void escape_times_scalar(const double* z_re, const double* z_im,
+                                const double* c_re, const double* c_im, size_t n,
+                                unsigned max_iterations, unsigned* counts)
+{
+  for (size_t i{}; i < n; ++i) {
+    double zr{ z_re[i] }, zi{ z_im[i] }, cr{ c_re[i] }, ci{ c_im[i] };
+    unsigned count{};
+    while (count < max_iterations) {
+      double zr2{ zr * zr }, zi2{ zi * zi };
+      zi = 2.0 * zr * zi + ci;
+      zr = zr2 - zi2 + cr;
+      if (!(zr * zr + zi * zi <= 4.0)) // Escaped - or overflowed to NaN
+        break;
+      ++count;
+    }
+    counts[i] = count;
+  }
+}
+
+#ifdef ESCAPE_TIME_X86
+// Iterate four pixels at a time
+__attribute__((target("avx2,fma"))) inline void
+escape_times_avx2(const double* z_re, const double* z_im, const double* c_re,
+                  const double* c_im, size_t n, unsigned max_iterations, unsigned* counts)
+{
+  const __m256d four{ _mm256_set1_pd(4.0) }, one{ _mm256_set1_pd(1.0) };
+  size_t i{};
+  for (; i + 4 <= n; i += 4) {
+    __m256d zr{ _mm256_loadu_pd(z_re + i) }, zi{ _mm256_loadu_pd(z_im + i) };
+    __m256d cr{ _mm256_loadu_pd(c_re + i) }, ci{ _mm256_loadu_pd(c_im + i) };
+    __m256d iterations{ _mm256_setzero_pd() };
+    __m256d active{ _mm256_castsi256_pd(_mm256_set1_epi64x(-1)) }; // All lanes iterate
+    for (unsigned k{}; k < max_iterations; ++k) {
+      __m256d zr2{ _mm256_mul_pd(zr, zr) }, zi2{ _mm256_mul_pd(zi, zi) };
+      __m256d zrzi{ _mm256_mul_pd(zr, zi) };
+      zi = _mm256_fmadd_pd(_mm256_set1_pd(2.0), zrzi, ci);
+      zr = _mm256_add_pd(_mm256_sub_pd(zr2, zi2), cr);
+      __m256d magnitude{ _mm256_add_pd(_mm256_mul_pd(zr, zr), _mm256_mul_pd(zi, zi)) };
+      active = _mm256_and_pd(active, _mm256_cmp_pd(magnitude, four, _CMP_LE_OQ));
+      if (!_mm256_movemask_pd(active)) // Every lane has escaped
+        break;
+      iterations = _mm256_add_pd(iterations, _mm256_and_pd(active, one));
+    }
+    alignas(32) double result[4];
+    _mm256_store_pd(result, iterations);
+    for (size_t lane{}; lane < 4; ++lane)
+      counts[i + lane] = static_cast<unsigned>(result[lane]);
+  }
+  escape_times_scalar(z_re + i, z_im + i, c_re + i, c_im + i, n - i, max_iterations,
+                      counts + i);
+}
+
+// Iterate eight pixels at a time
+__attribute__((target("avx512f"))) inline void
+escape_times_avx512(const double* z_re, const double* z_im, const double* c_re,
+                    const double* c_im, size_t n, unsigned max_iterations,
+                    unsigned* counts)
+{
+  const __m512d four{ _mm512_set1_pd(4.0) }, one{ _mm512_set1_pd(1.0) };
+  size_t i{};
+  for (; i + 8 <= n; i += 8) {
+    __m512d zr{ _mm512_loadu_pd(z_re + i) }, zi{ _mm512_loadu_pd(z_im + i) };
+    __m512d cr{ _mm512_loadu_pd(c_re + i) }, ci{ _mm512_loadu_pd(c_im + i) };
+    __m512d iterations{ _mm512_setzero_pd() };
+    __mmask8 active{ 0xFF }; // All lanes iterate
+    for (unsigned k{}; k < max_iterations; ++k) {
+      __m512d zr2{ _mm512_mul_pd(zr, zr) }, zi2{ _mm512_mul_pd(zi, zi) };
+      __m512d zrzi{ _mm512_mul_pd(zr, zi) };
+      zi = _mm512_fmadd_pd(_mm512_set1_pd(2.0), zrzi, ci);
+      zr = _mm512_add_pd(_mm512_sub_pd(zr2, zi2), cr);
+      __m512d magnitude{ _mm512_add_pd(_mm512_mul_pd(zr, zr), _mm512_mul_pd(zi, zi)) };
+      active = _mm512_mask_cmp_pd_mask(active, magnitude, four, _CMP_LE_OQ);
+      if (!active) // Every lane has escaped
+        break;
+      iterations = _mm512_mask_add_pd(iterations, active, iterations, one);
+    }
+    alignas(64) double result[8];
+    _mm512_store_pd(result, iterations);
+    for (size_t lane{}; lane < 8; ++lane)
+      counts[i + lane] = static_cast<unsigned>(result[lane]);
+  }
+  escape_times_scalar(z_re + i, z_im + i, c_re + i, c_im + i, n - i, max_iterations,
+                      counts + i);
+}
+#endif
+
+// An escape-time kernel and its name
+struct Named_Kernel {
+  std::string name;
+  Escape_Kernel kernel;
+};
+
+// Return the kernels this processor can run, fastest last
+inline std::vector<Named_Kernel> escape_kernels()
+{
+  std::vector<Named_Kernel> kernels{ { "scalar", escape_times_scalar } };
+#ifdef ESCAPE_TIME_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    kernels.push_back({ "AVX2", escape_times_avx2 });
+  if (__builtin_cpu_supports("avx512f"))
+    kernels.push_back({ "AVX-512", escape_times_avx512 });
+#endif
+  return kernels;
+}
+
+// Return the fastest kernel this processor can run
+inline Escape_Kernel best_escape_kernel()
+{
+  static const Escape_Kernel best{ escape_kernels().back().kernel };
+  return best;
+}
+#endif
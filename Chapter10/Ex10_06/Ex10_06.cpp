@@ -0,0 +1,179 @@
+// Ex10_06.cpp
+// Using complex object to generate a fractal image of a Julia set
+
+#include <chrono>   // For clocks, duration, and time_point
+#include <complex>  // For complex types
+#include <iomanip>  // For stream manipulators
+#include <iostream> // For standard streams
+#include <string>   // For string class
+#include <vector>   // For vector container
+
+#include "Benchmark.h"
+#include "Escape_Time.h"
+#include "Fractal_Renderer.h"
+
+using std::complex;
+using namespace std::chrono;
+using namespace std::literals;
+
+// Render an image to a file - a .ppm file is in color, anything else is gray PGM
+// The arguments are: julia|mandelbrot width height file [iterations [threads]]
+int render(int argc, char* argv[])
+{
+  if (argc < 4) {
+    std::cerr << "Usage: Ex10_06 --render julia|mandelbrot width height file "
+                 "[iterations [threads]]"
+              << std::endl;
+    return 1;
+  }
+  bool mandelbrot{ std::string{ argv[0] } == "mandelbrot" };
+  auto settings = default_view(mandelbrot ? Fractal::mandelbrot : Fractal::julia);
+  settings.width = std::stoul(argv[1]);
+  settings.height = std::stoul(argv[2]);
+  std::string file_name{ argv[3] };
+  settings.color
+    = file_name.size() > 4 && file_name.substr(file_name.size() - 4) == ".ppm";
+  if (argc > 4)
+    settings.max_iterations = std::stoul(argv[4]);
+  if (argc > 5)
+    settings.threads = std::stoul(argv[5]);
+  if (settings.max_iterations == 0) { // Shading divides by the number of iterations
+    std::cerr << "The number of iterations must be at least 1." << std::endl;
+    return 1;
+  }
+
+  auto start_time = std::chrono::steady_clock::now();
+  if (!render_to_file(settings, file_name)) {
+    std::cerr << file_name << " not written." << std::endl;
+    return 1;
+  }
+  auto end_time = std::chrono::steady_clock::now();
+  auto elapsed = end_time - start_time.time_since_epoch();
+  std::cout << "Time to render " << argv[0] << " set with " << settings.width << "x"
+            << settings.height << " pixels to " << file_name << " is ";
+  print_timepoint(elapsed, 9);
+  return 0;
+}
+
+// Time generating a size x size Julia set image with complex<double> and with each
+// escape-time kernel. The arguments are the options for parse_benchmark_options().
+int bench(int argc, char* argv[])
+{
+  Benchmark_Options options;
+  if (!parse_benchmark_options(argc, argv, 0, options)) {
+    std::cerr << "Usage: Ex10_06 --bench [--samples N] [--warmup N] [--max-seconds S] "
+                 "[--filter TEXT] [--json FILE] [--no-pin]"
+              << std::endl;
+    return 1;
+  }
+
+  const size_t size{ 512 };    // Image width and height
+  const unsigned count{ 100 }; // Iterate count for recursion
+  complex<double> c{ -0.7, 0.27015 };
+  std::vector<unsigned> counts(size * size);
+  auto z_value = [size](size_t i, size_t j) { // Point in the complex plane for a pixel
+    return complex<double>{ 1.5 * (double(i) - size / 2) / (0.5 * size),
+                            (double(j) - size / 2) / (0.5 * size) };
+  };
+
+  Benchmark_Suite suite{ "Ex10_06 Julia set" };
+  suite.add("complex<double>", [&] {
+    for (size_t i{}; i < size; ++i)
+      for (size_t j{}; j < size; ++j) {
+        auto z = z_value(i, j);
+        for (size_t k{}; k < count; ++k)
+          z = z * z + c;
+        counts[i * size + j] = std::abs(z) < 2.0;
+      }
+    do_not_optimize(counts.data());
+  });
+
+  std::vector<double> z_re(size), z_im(size), c_re(size, c.real()), c_im(size, c.imag());
+  for (const auto& k : escape_kernels())
+    suite.add(k.name + " escape-time", [&, kernel = k.kernel] {
+      for (size_t i{}; i < size; ++i) {
+        for (size_t j{}; j < size; ++j) {
+          auto z = z_value(i, j);
+          z_re[j] = z.real();
+          z_im[j] = z.imag();
+        }
+        kernel(z_re.data(), z_im.data(), c_re.data(), c_im.data(), size, count,
+               &counts[i * size]);
+      }
+      do_not_optimize(counts.data());
+    });
+  suite.run_and_report(options);
+  return 0;
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc > 1 && std::string{ argv[1] } == "--render")
+    return render(argc - 2, argv + 2);
+  if (argc > 1 && std::string{ argv[1] } == "--bench")
+    return bench(argc - 2, argv + 2);
+
+  const int width{ 100 }, height{ 100 }; // Image width and height
+  size_t count{ 100 };                   // Iterate count for recursion
+  char image[width][height];
+  auto start_time = std::chrono::steady_clock::now(); // time_point object for start
+  complex<double> c{ -0.7, 0.27015 };                 // Constant in z = z*z + c
+
+  for (int i{}; i < width; ++i) // Iterate over pixels in the width
+  {
+    for (int j{}; j < height; ++j) // Iterate over pixels in the height
+    {
+      // Scale real and imaginary parts to be between -1 and +1
+      auto re = 1.5 * (i - width / 2) / (0.5 * width);
+      auto im = (j - height / 2) / (0.5 * height);
+      complex<double> z{ re, im }; // Point in the complex plane
+      image[i][j] = ' ';           // Point not in the Julia set
+      // Iterate z=z*z+c count times
+      for (size_t k{}; k < count; ++k) {
+        z = z * z + c;
+      }
+      if (std::abs(z) < 2.0) // If point not escaping...
+        image[i][j] = '*';   // ...it's in the Julia set
+    }
+  }
+  auto end_time = std::chrono::steady_clock::now(); // time_point object for end
+  auto elapsed = end_time - start_time.time_since_epoch();
+  std::cout << "Time to generate a Julia set with " << width << "x" << height
+            << " pixels is ";
+  print_timepoint(elapsed, 9);
+
+  // Generate the image again with escape-time kernels that stop iterating a pixel when
+  // it escapes. A column of pixels is processed by each kernel call.
+  std::vector<double> z_re(height), z_im(height);                     // Starting values
+  std::vector<double> c_re(height, c.real()), c_im(height, c.imag()); // Constants
+  std::vector<unsigned> counts(width * height); // Iterations survived by each pixel
+  for (const auto& k : escape_kernels()) {
+    start_time = std::chrono::steady_clock::now();
+    for (int i{}; i < width; ++i) {
+      for (int j{}; j < height; ++j) {
+        z_re[j] = 1.5 * (i - width / 2) / (0.5 * width);
+        z_im[j] = (j - height / 2) / (0.5 * height);
+      }
+      k.kernel(z_re.data(), z_im.data(), c_re.data(), c_im.data(), height,
+               static_cast<unsigned>(count), &counts[i * height]);
+    }
+    end_time = std::chrono::steady_clock::now();
+    elapsed = end_time - start_time.time_since_epoch();
+    std::cout << "Time with the " << k.name << " escape-time kernel is ";
+    print_timepoint(elapsed, 9);
+
+    size_t differences{}; // Pixels that differ from the first image
+    for (int i{}; i < width; ++i)
+      for (int j{}; j < height; ++j)
+        differences += (counts[i * height + j] == count) != (image[i][j] == '*');
+    if (differences)
+      std::cout << "  " << differences << " pixels differ from the first image.\n";
+  }
+
+  std::cout << "The Julia set looks like this:\n";
+  for (size_t i{}; i < width; ++i) {
+    for (size_t j{}; j < height; ++j)
+      std::cout << image[i][j];
+    std::cout << '\n';
+  }
+}
@@ -0,0 +1,138 @@
+// Fractal_Renderer.h for Ex10_06
+// Renders Julia and Mandelbrot sets of any size to binary PGM or PPM image files
+// The image is divided into bands of rows and each band into square tiles. The tiles
+// in a band are rendered as separate tasks by a work-stealing thread pool, because
+// tiles near the set take many more iterations than tiles far from it. While one band
+// is being rendered, the previous band is written to the file, so only two bands of
+// pixels are in memory whatever the image size.
+
+#ifndef FRACTAL_RENDERER_H
+#define FRACTAL_RENDERER_H
+
+#include <algorithm> // For min()
+#include <complex>   // For complex types
+#include <cstdint>   // For uint8_t
+#include <fstream>   // For file streams
+#include <string>    // For string class
+#include <thread>    // For hardware_concurrency()
+#include <vector>    // For vector container
+
+#include "Escape_Time.h"
+#include "Thread_Pool.h"
+
+enum class Fractal { julia, mandelbrot };
+
+struct Render_Settings {
+  Fractal type{ Fractal::julia };
+  size_t width{ 1024 };                    // Image width in pixels
+  size_t height{ 1024 };                   // Image height in pixels
+  unsigned max_iterations{ 100 };          // Iterations for a point in the set
+  std::complex<double> c{ -0.7, 0.27015 }; // Constant for a Julia set
+  std::complex<double> centre{ 0.0, 0.0 }; // Point at the centre of the image
+  double span{ 3.0 };                      // Width of the image in the complex plane
+  bool color{ false };                     // PPM color image if true, otherwise PGM
+  size_t tile_size{ 64 };                  // Tile width and height in pixels
+  size_t threads{ std::thread::hardware_concurrency() }; // Threads in the pool
+};
+
+// Settings for the default view of each fractal
+inline Render_Settings default_view(Fractal type)
+{
+  Render_Settings settings;
+  settings.type = type;
+  if (type == Fractal::mandelbrot) {
+    settings.centre = { -0.75, 0.0 };
+    settings.span = 3.5;
+  }
+  return settings;
+}
+
+// Bytes per pixel in the image file
+inline size_t pixel_bytes(const Render_Settings& settings)
+{
+  return settings.color ? 3 : 1;
+}
+
+// Convert an iteration count to a pixel - points in the set are black
+inline void shade(unsigned count, unsigned max_iterations, bool color, uint8_t* pixel)
+{
+  double t{ static_cast<double>(count) / max_iterations }; // 0 to 1
+  if (!color) {
+    pixel[0] = static_cast<uint8_t>(255.0 * (1.0 - t));
+    return;
+  }
+  double u{ 1.0 - t };
+  pixel[0] = static_cast<uint8_t>(9.0 * u * t * t * t * 255.0);
+  pixel[1] = static_cast<uint8_t>(15.0 * u * u * t * t * 255.0);
+  pixel[2] = static_cast<uint8_t>(8.5 * u * u * u * t * 255.0);
+}
+
+// Render the tile with its top-left corner at pixel (x0, y0) into a band of rows that
+// starts at image row band_y
+inline void render_tile(const Render_Settings& settings, size_t x0, size_t y0,
+                        size_t band_y, uint8_t* band)
+{
+  size_t tile_width{ std::min(settings.tile_size, settings.width - x0) };
+  size_t tile_height{ std::min(settings.tile_size, settings.height - y0) };
+  double scale{ settings.span / settings.width }; // Size of a pixel in the plane
+  double left{ settings.centre.real() - 0.5 * settings.span };
+  double top{ settings.centre.imag() + 0.5 * scale * settings.height };
+  bool julia{ settings.type == Fractal::julia };
+
+  std::vector<double> z_re(tile_width), z_im(tile_width), c_re(tile_width),
+    c_im(tile_width);
+  std::vector<unsigned> counts(tile_width);
+  auto kernel = best_escape_kernel();
+  size_t row_bytes{ settings.width * pixel_bytes(settings) };
+  for (size_t y{ y0 }; y < y0 + tile_height; ++y) {
+    double im{ top - scale * y };
+    for (size_t i{}; i < tile_width; ++i) {
+      double re{ left + scale * (x0 + i) };
+      z_re[i] = julia ? re : 0.0; // Julia: z starts at the point and c is fixed
+      z_im[i] = julia ? im : 0.0;
+      c_re[i] = julia ? settings.c.real() : re; // Mandelbrot: z starts at 0, c is the
+      c_im[i] = julia ? settings.c.imag() : im; // point
+    }
+    kernel(z_re.data(), z_im.data(), c_re.data(), c_im.data(), tile_width,
+           settings.max_iterations, counts.data());
+    uint8_t* pixel{ band + (y - band_y) * row_bytes + x0 * pixel_bytes(settings) };
+    for (size_t i{}; i < tile_width; ++i, pixel += pixel_bytes(settings))
+      shade(counts[i], settings.max_iterations, settings.color, pixel);
+  }
+}
+
+// Render an image to a binary PGM (gray) or PPM (color) file
+inline bool render_to_file(const Render_Settings& settings, const std::string& file_name)
+{
+  std::ofstream out{ file_name,
+                     std::ios_base::out | std::ios_base::trunc | std::ios_base::binary };
+  if (!out)
+    return false;
+  out << (settings.color ? "P6\n" : "P5\n") << settings.width << ' ' << settings.height
+      << "\n255\n";
+
+  Thread_Pool pool{ settings.threads };
+  size_t band_rows{ settings.tile_size };
+  size_t row_bytes{ settings.width * pixel_bytes(settings) };
+  std::vector<uint8_t> bands[2]{ std::vector<uint8_t>(band_rows * row_bytes),
+                                 std::vector<uint8_t>(band_rows * row_bytes) };
+  size_t previous_rows{}; // Rows in the band waiting to be written
+  size_t band{};          // Index of the band being rendered
+  for (size_t band_y{}; band_y < settings.height; band_y += band_rows, band ^= 1) {
+    for (size_t x0{}; x0 < settings.width; x0 += settings.tile_size)
+      pool.submit([&settings, &bands, x0, band_y, band] {
+        render_tile(settings, x0, band_y, band_y, bands[band].data());
+      });
+
+    // Write the previous band while this one is rendered
+    out.write(reinterpret_cast<const char*>(bands[band ^ 1].data()),
+              previous_rows * row_bytes);
+    pool.wait();
+    previous_rows = std::min(band_rows, settings.height - band_y);
+    if (band_y + band_rows >= settings.height) // Last band
+      out.write(reinterpret_cast<const char*>(bands[band].data()),
+                previous_rows * row_bytes);
+  }
+  return static_cast<bool>(out);
+}
+#endif
@@ -0,0 +1,134 @@
+// Anagram_Index.h
+// An index of words keyed by their signature - the letters of the word in sorted order
+// Words that are anagrams of each other have the same signature, so all the anagrams of
+// a word are found with one hash table lookup, however long the word is. The index can
+// be built by several threads: each thread computes the signatures for a chunk of the
+// words, then each thread collects the entries for one shard of the signatures, so no
+// locking is needed and every word is inserted once.
+// The index stores string_view objects, so the words it is built from - a
+// Mapped_Dictionary, for instance - must outlive it.
+
+#ifndef ANAGRAM_INDEX_H
+#define ANAGRAM_INDEX_H
+
+#include <algorithm>     // For sort(), max()
+#include <cctype>        // For tolower()
+#include <functional>    // For hash
+#include <string>        // For string class
+#include <string_view>   // For string_view
+#include <unordered_map> // For unordered_map container
+#include <vector>        // For vector container
+
+#include "Thread_Pool.h"
+
+class Anagram_Index {
+public:
+  using Group = std::vector<std::string_view>; // Words with the same signature
+
+private:
+  std::unordered_map<std::string, Group> groups;
+  size_t n_words{};
+
+public:
+  Anagram_Index() = default;
+
+  // Index the words using n_threads threads - Words can be any container with size()
+  // and operator[] that provides elements convertible to string_view. Duplicate words
+  // are stored once. Words in a group are in the order they appear.
+  template <typename Words>
+  Anagram_Index(const Words& words, size_t n_threads = 1)
+  {
+    n_threads = std::max(n_threads, size_t{ 1 });
+    if (n_threads == 1) {
+      for (const auto& word : words)
+        add(word);
+      return;
+    }
+
+    // Compute the signatures for each chunk of words, recording the shard for each
+    size_t n_chunks{ n_threads };
+    std::vector<std::vector<std::string>> signatures(n_chunks);
+    std::vector<std::vector<size_t>> shards(n_chunks);
+    Thread_Pool pool{ n_threads };
+    pool.parallel_for(n_chunks, [&](size_t chunk) {
+      size_t first{ words.size() * chunk / n_chunks };
+      size_t last{ words.size() * (chunk + 1) / n_chunks };
+      for (size_t i{ first }; i < last; ++i) {
+        signatures[chunk].push_back(signature(words[i]));
+        shards[chunk].push_back(std::hash<std::string>{}(signatures[chunk].back())
+                                % n_threads);
+      }
+    });
+
+    // Each thread builds the groups for one shard of the signatures, taking the
+    // chunks in order so the words stay in their original order
+    std::vector<std::unordered_map<std::string, Group>> shard_groups(n_threads);
+    std::vector<size_t> shard_words(n_threads);
+    pool.parallel_for(n_threads, [&](size_t shard) {
+      for (size_t chunk{}; chunk < n_chunks; ++chunk) {
+        size_t first{ words.size() * chunk / n_chunks };
+        for (size_t i{}; i < signatures[chunk].size(); ++i) {
+          if (shards[chunk][i] != shard)
+            continue;
+          auto& group = shard_groups[shard][signatures[chunk][i]];
+          std::string_view word{ words[first + i] };
+          if (std::find(std::begin(group), std::end(group), word) == std::end(group)) {
+            group.push_back(word);
+            ++shard_words[shard];
+          }
+        }
+      }
+    });
+
+    for (size_t shard{}; shard < n_threads; ++shard) {
+      groups.merge(shard_groups[shard]); // Signatures in different shards are distinct
+      n_words += shard_words[shard];
+    }
+  }
+
+  // Return the signature of a word - its letters in lowercase and in sorted order
+  static std::string signature(std::string_view word)
+  {
+    std::string letters(word.size(), ' ');
+    for (size_t i{}; i < word.size(); ++i)
+      letters[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(word[i])));
+    std::sort(std::begin(letters), std::end(letters));
+    return letters;
+  }
+
+  // Add a word to the index - returns false if it is already there
+  bool add(std::string_view word)
+  {
+    auto& group = groups[signature(word)];
+    if (std::find(std::begin(group), std::end(group), word) != std::end(group))
+      return false;
+    group.push_back(word);
+    ++n_words;
+    return true;
+  }
+
+  // Return the indexed words that are anagrams of a word, including the word itself
+  const Group& find(std::string_view word) const
+  {
+    static const Group none;
+    auto iter = groups.find(signature(word));
+    return iter == std::end(groups) ? none : iter->second;
+  }
+
+  // Return every group with at least min_size words, largest groups first
+  std::vector<const Group*> anagram_groups(size_t min_size = 2) const
+  {
+    std::vector<const Group*> result;
+    for (const auto& pr : groups)
+      if (pr.second.size() >= min_size)
+        result.push_back(&pr.second);
+    std::sort(std::begin(result), std::end(result), [](const Group* a, const Group* b) {
+      return a->size() != b->size() ? a->size() > b->size() : a->front() < b->front();
+    });
+    return result;
+  }
+
+  size_t words() const { return n_words; }
+  size_t signatures() const { return groups.size(); }
+};
+#endif
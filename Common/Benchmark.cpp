@@ -0,0 +1,249 @@
+// Benchmark.cpp
+// Functions to time kernels and report the results
+
+#include "Benchmark.h"
+
+#include <algorithm> // For sort(), max(), min()
+#include <cmath>     // For sqrt(), abs(), ceil()
+#include <fstream>   // For file streams
+#include <numeric>   // For accumulate()
+#include <string>    // For string class, stoul(), stod()
+
+#if defined(__linux__)
+#include <sched.h>  // For sched_setaffinity(), sched_getcpu()
+#include <unistd.h> // For sysconf()
+#endif
+
+using namespace std::chrono;
+
+namespace {
+// Pin the calling thread to the processor it is running on
+void pin_thread()
+{
+#if defined(__linux__)
+  int cpu{ sched_getcpu() };
+  if (cpu < 0)
+    return;
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  CPU_SET(cpu, &cpus);
+  sched_setaffinity(0, sizeof(cpus), &cpus);
+#endif
+}
+
+// Time a fixed amount of work that depends only on the processor clock speed
+double calibration_time()
+{
+  double best{ 1e30 };
+  for (int repeat{}; repeat < 5; ++repeat) { // Best of five to ignore interruptions
+    auto start = steady_clock::now();
+    unsigned long long x{ 88172645463325252ULL };
+    for (int i{}; i < 200'000; ++i) { // xorshift - a chain of dependent operations
+      x ^= x << 13;
+      x ^= x >> 7;
+      x ^= x << 17;
+    }
+    do_not_optimize(x);
+    best = std::min(best, duration<double>(steady_clock::now() - start).count());
+  }
+  return best;
+}
+
+// Return the value at proportion p through sorted values
+double percentile(const std::vector<double>& sorted, double p)
+{
+  if (sorted.empty())
+    return 0.0;
+  size_t index{ static_cast<size_t>(std::ceil(p * sorted.size())) };
+  return sorted[std::min(std::max(index, size_t{ 1 }), sorted.size()) - 1];
+}
+
+// Write a string as a JSON string
+void write_json_string(const std::string& str, std::ostream& out)
+{
+  out << '"';
+  for (char ch : str) {
+    if (ch == '"' || ch == '\\')
+      out << '\\' << ch;
+    else if (static_cast<unsigned char>(ch) < 0x20)
+      out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+          << static_cast<int>(ch) << std::dec << std::setfill(' ');
+    else
+      out << ch;
+  }
+  out << '"';
+}
+} // namespace
+
+Benchmark_Result Benchmark_Suite::measure(const Kernel& kernel,
+                                          const Benchmark_Options& options) const
+{
+  auto run_once = [&kernel] {
+    if (kernel.setup)
+      kernel.setup();
+    auto start = steady_clock::now();
+    kernel.run();
+    return duration<double>(steady_clock::now() - start).count();
+  };
+
+  // Warm up, measuring the time for one run
+  double warmup_time{}, single_run{ 1e30 };
+  for (size_t i{}; i < options.warmup_iterations || warmup_time < options.warmup_seconds;
+       ++i) {
+    double t{ run_once() };
+    warmup_time += t;
+    single_run = std::min(single_run, t);
+    if (warmup_time > options.max_seconds)
+      break;
+  }
+
+  // Choose the number of runs for each sample
+  Benchmark_Result result;
+  result.name = kernel.name;
+  result.batch = 1;
+  if (!kernel.setup && single_run < options.min_sample_seconds)
+    result.batch
+      = static_cast<size_t>(options.min_sample_seconds / std::max(single_run, 1e-9)) + 1;
+
+  double calibration_before{ calibration_time() };
+  std::vector<double> times;
+  double total{};
+  while (times.size() < std::max(options.samples, size_t{ 1 })) {
+    double t{};
+    if (result.batch == 1)
+      t = run_once();
+    else {
+      auto start = steady_clock::now();
+      for (size_t i{}; i < result.batch; ++i)
+        kernel.run();
+      t = duration<double>(steady_clock::now() - start).count() / result.batch;
+    }
+    times.push_back(t);
+    total += t * result.batch;
+    if (total > options.max_seconds && times.size() >= 3)
+      break;
+  }
+  double calibration_after{ calibration_time() };
+  result.speed_change = (calibration_after - calibration_before) / calibration_before;
+  result.stable = std::abs(result.speed_change) <= 0.05;
+
+  std::sort(std::begin(times), std::end(times));
+  result.samples = times.size();
+  result.min = times.front();
+  result.max = times.back();
+  result.median = percentile(times, 0.5);
+  result.p95 = percentile(times, 0.95);
+  result.p99 = percentile(times, 0.99);
+  result.mean = std::accumulate(std::begin(times), std::end(times), 0.0) / times.size();
+  double sum_squares{};
+  for (auto t : times)
+    sum_squares += (t - result.mean) * (t - result.mean);
+  result.stddev = times.size() > 1 ? std::sqrt(sum_squares / (times.size() - 1)) : 0.0;
+  return result;
+}
+
+std::vector<Benchmark_Result> Benchmark_Suite::run(const Benchmark_Options& options) const
+{
+  if (options.pin_thread)
+    pin_thread();
+  std::vector<Benchmark_Result> results;
+  for (const auto& kernel : kernels)
+    if (kernel.name.find(options.filter) != std::string::npos)
+      results.push_back(measure(kernel, options));
+  return results;
+}
+
+std::vector<Benchmark_Result>
+Benchmark_Suite::run_and_report(const Benchmark_Options& options, std::ostream& out) const
+{
+  auto results = run(options);
+  print_results(results, out);
+  if (!options.json_file.empty()) {
+    std::ofstream json{ options.json_file, std::ios_base::out | std::ios_base::trunc };
+    if (!json)
+      std::cerr << options.json_file << " not open." << std::endl;
+    else
+      write_json(suite_name, results, json);
+  }
+  return results;
+}
+
+void print_results(const std::vector<Benchmark_Result>& results, std::ostream& out)
+{
+  size_t name_width{ 6 };
+  for (const auto& result : results)
+    name_width = std::max(name_width, result.name.length() + 2);
+
+  out << std::left << std::setw(name_width) << "kernel" << std::right << std::setw(9)
+      << "samples" << std::setw(14) << "min (s)" << std::setw(14) << "median (s)"
+      << std::setw(14) << "p95 (s)" << std::setw(14) << "p99 (s)" << std::setw(14)
+      << "stddev (s)" << '\n';
+  for (const auto& result : results) {
+    out << std::left << std::setw(name_width) << result.name << std::right << std::setw(9)
+        << result.samples << std::scientific << std::setprecision(4) << std::setw(14)
+        << result.min << std::setw(14) << result.median << std::setw(14) << result.p95
+        << std::setw(14) << result.p99 << std::setw(14) << result.stddev
+        << std::defaultfloat;
+    if (!result.stable)
+      out << "  processor speed changed by " << std::fixed << std::setprecision(1)
+          << 100.0 * result.speed_change << '%' << std::defaultfloat;
+    out << '\n';
+  }
+  out << std::flush;
+}
+
+void write_json(const std::string& suite, const std::vector<Benchmark_Result>& results,
+                std::ostream& out)
+{
+  out << "{\n  \"suite\": ";
+  write_json_string(suite, out);
+  out << ",\n  \"unit\": \"seconds\",\n  \"results\": [";
+  out << std::setprecision(9);
+  for (size_t i{}; i < results.size(); ++i) {
+    const auto& r = results[i];
+    out << (i ? ",\n" : "\n") << "    { \"name\": ";
+    write_json_string(r.name, out);
+    out << ", \"samples\": " << r.samples << ", \"batch\": " << r.batch
+        << ", \"min\": " << r.min << ", \"median\": " << r.median
+        << ", \"mean\": " << r.mean << ", \"p95\": " << r.p95 << ", \"p99\": " << r.p99
+        << ", \"max\": " << r.max
+        << ", \"stddev\": " << r.stddev << ", \"speed_change\": " << r.speed_change
+        << ", \"stable\": " << (r.stable ? "true" : "false") << " }";
+  }
+  out << "\n  ]\n}\n";
+}
+
+size_t resident_memory()
+{
+#if defined(__linux__)
+  std::ifstream statm{ "/proc/self/statm" }; // Sizes in pages: total, then resident
+  size_t total_pages{}, resident_pages{};
+  if (statm >> total_pages >> resident_pages)
+    return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+  return 0;
+}
+
+bool parse_benchmark_options(int argc, char* argv[], int first,
+                             Benchmark_Options& options)
+{
+  for (int i{ first }; i < argc; ++i) {
+    std::string arg{ argv[i] };
+    bool has_value{ i + 1 < argc };
+    if (arg == "--no-pin")
+      options.pin_thread = false;
+    else if (arg == "--samples" && has_value)
+      options.samples = std::stoul(argv[++i]);
+    else if (arg == "--warmup" && has_value)
+      options.warmup_iterations = std::stoul(argv[++i]);
+    else if (arg == "--max-seconds" && has_value)
+      options.max_seconds = std::stod(argv[++i]);
+    else if (arg == "--filter" && has_value)
+      options.filter = argv[++i];
+    else if (arg == "--json" && has_value)
+      options.json_file = argv[++i];
+    else
+      return false;
+  }
+  return true;
+}
@@ -0,0 +1,135 @@
+// Benchmark.h
+// A small harness for timing code
+// Kernels are registered with a Benchmark_Suite under a name. Running the suite times
+// each kernel after warming it up, collecting repeated samples, and reports the
+// minimum, median, 95th and 99th percentiles, and standard deviation of the samples.
+// Results can be written as JSON to track performance between releases.
+//
+// Steps to reduce the effects of processor speed changes on the results:
+// - The thread running the kernels is pinned to one processor so it is not migrated.
+// - Each kernel runs repeatedly for a minimum warmup time before it is timed, which
+//   brings the processor up to its working clock speed and warms the caches.
+// - A fixed calibration loop is timed before and after the samples for each kernel;
+//   if its time changes by more than 5%, the result is marked as unstable.
+// - Very fast kernels are run in batches so each sample is long enough to time.
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <chrono>     // For clocks, duration, and time_point
+#include <cstddef>    // For size_t
+#include <functional> // For function
+#include <iomanip>    // For stream manipulators
+#include <iostream>   // For standard streams
+#include <string>     // For string class
+#include <vector>     // For vector container
+
+// Outputs the exact interval in seconds for a time_point<>
+template <typename TimePoint>
+void print_timepoint(const TimePoint& tp, size_t places = 0)
+{
+  auto elapsed = tp.time_since_epoch(); // duration object for the interval
+
+  auto seconds
+    = std::chrono::duration_cast<std::chrono::duration<double>>(elapsed).count();
+  std::cout << std::fixed << std::setprecision(places) << seconds << " seconds\n";
+}
+
+// Prevents the compiler discarding a value that is computed but not otherwise used
+template <typename T>
+inline void do_not_optimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+struct Benchmark_Options {
+  size_t warmup_iterations{ 3 };      // Minimum untimed runs of each kernel
+  double warmup_seconds{ 0.1 };       // Minimum untimed run time for each kernel
+  size_t samples{ 20 };               // Timed samples for each kernel...
+  double max_seconds{ 10.0 };         // ...unless this time is used up first
+  double min_sample_seconds{ 0.001 }; // Kernels faster than this are run in batches
+  bool pin_thread{ true };            // Pin the timing thread to one processor
+  std::string filter;                 // Only run kernels with names containing this
+  std::string json_file;              // File for JSON results - none if empty
+};
+
+// Statistics for one kernel - times are in seconds for one run of the kernel
+struct Benchmark_Result {
+  std::string name;
+  size_t samples{};         // Number of samples
+  size_t batch{};           // Kernel runs in each sample
+  double min{};
+  double median{};
+  double mean{};
+  double p95{};             // 95th percentile
+  double p99{};             // 99th percentile
+  double max{};
+  double stddev{};          // Standard deviation
+  double speed_change{};    // Relative change in the calibration loop time
+  bool stable{ true };      // false if the processor speed changed during sampling
+};
+
+class Benchmark_Suite {
+private:
+  struct Kernel {
+    std::string name;
+    std::function<void()> setup; // Called before each run without being timed
+    std::function<void()> run;   // The code to be timed
+  };
+  std::string suite_name;
+  std::vector<Kernel> kernels;
+
+  Benchmark_Result measure(const Kernel& kernel, const Benchmark_Options& options) const;
+
+public:
+  explicit Benchmark_Suite(const std::string& name)
+    : suite_name(name)
+  {
+  }
+
+  // Register a kernel
+  void add(const std::string& name, std::function<void()> run)
+  {
+    kernels.push_back({ name, nullptr, std::move(run) });
+  }
+
+  // Register a kernel that needs setup - a fresh copy of its data, for instance -
+  // before each run. Kernels with setup are not batched.
+  void add(const std::string& name, std::function<void()> setup,
+           std::function<void()> run)
+  {
+    kernels.push_back({ name, std::move(setup), std::move(run) });
+  }
+
+  const std::string& name() const { return suite_name; }
+
+  // Run the kernels and return the results
+  std::vector<Benchmark_Result> run(const Benchmark_Options& options) const;
+
+  // Run the kernels, output a table of results and write JSON if a file is specified
+  std::vector<Benchmark_Result> run_and_report(const Benchmark_Options& options,
+                                               std::ostream& out = std::cout) const;
+};
+
+// Output results as a table
+void print_results(const std::vector<Benchmark_Result>& results, std::ostream& out);
+
+// Write results as a JSON object
+void write_json(const std::string& suite, const std::vector<Benchmark_Result>& results,
+                std::ostream& out);
+
+// Return the memory of this process that is resident in RAM in bytes, or 0 if it is
+// not known
+size_t resident_memory();
+
+// Set options from command line arguments starting at argv[first]:
+// --samples N  --warmup N  --max-seconds S  --filter TEXT  --json FILE  --no-pin
+// Returns false if an argument is not recognized.
+bool parse_benchmark_options(int argc, char* argv[], int first,
+                             Benchmark_Options& options);
+#endif
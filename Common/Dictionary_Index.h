@@ -0,0 +1,350 @@
+// Dictionary_Index.h
+// A prebuilt binary index of a dictionary that is used by mapping it into memory
+// write_dictionary_index() compiles a text dictionary into a file that contains:
+// - a header with a magic string, version number, the size and modification time of
+//   the text file, and the offset of each table
+// - the words, sorted and separated by newlines, as one blob of characters
+// - a table of offsets of the words in the blob
+// - a minimal perfect hash table that maps every word to a unique slot
+// - the word indexes grouped by anagram signature, with a hash table of the groups
+// Dictionary_Index maps the file read-only and uses the tables in place. Opening it
+// reads only the header: it checks that the text file has not changed since the index
+// was compiled and that every table fits in the file, so a stale file is rejected and
+// the caller reads the text file instead. A lookup checks each entry it reads before
+// using it, so a damaged table gives no answer rather than reading outside the file,
+// and a lookup touches only a few pages.
+// The file is written in the byte order of the processor that creates it, and is
+// rejected by a processor with a different byte order.
+//
+// The perfect hash uses hash and displace: each word is assigned to a bucket by one
+// hash function, and each bucket stores a displacement d that selects a second hash
+// function placing all the words in the bucket in empty slots. Buckets with one word
+// store the slot itself, encoded as -(slot + 1).
+
+#ifndef DICTIONARY_INDEX_H
+#define DICTIONARY_INDEX_H
+
+#include <algorithm>   // For sort(), lower_bound()
+#include <cstdint>     // For fixed width integer types
+#include <cstring>     // For memcmp(), memcpy()
+#include <filesystem>  // For file_size(), last_write_time()
+#include <fstream>     // For file streams
+#include <string>      // For string class
+#include <string_view> // For string_view
+#include <vector>      // For vector container
+
+#include "Anagram_Index.h"
+#include "Mapped_Dictionary.h"
+#include "Mapped_File.h"
+
+namespace dictionary_index {
+const char magic[8]{ 'S', 'T', 'L', 'D', 'I', 'C', 'T', '\0' };
+const uint32_t version{ 2 };
+const uint32_t byte_order{ 0x01020304 }; // Reads differently in the other byte order
+
+// The header at the start of the file - offsets are from the start of the file
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order;
+  uint32_t word_count;
+  uint32_t group_count;          // Number of anagram signatures
+  uint32_t signature_slots;      // Size of the signature hash table - a power of 2
+  uint32_t reserved;
+  uint64_t file_size;
+  uint64_t source_size;          // Size of the text file the index was compiled from
+  int64_t source_time;           // Its last write time in ticks of the file clock
+  uint64_t blob_offset;          // Words separated by newlines
+  uint64_t blob_size;
+  uint64_t offsets_offset;       // word_count+1 uint32_t offsets of words in the blob
+  uint64_t displacements_offset; // word_count int32_t displacements, one per bucket
+  uint64_t slots_offset;         // word_count uint32_t word indexes, one per slot
+  uint64_t group_words_offset;   // word_count uint32_t word indexes in signature order
+  uint64_t group_starts_offset;  // group_count+1 uint32_t starts of each group
+  uint64_t signatures_offset;    // signature_slots uint32_t group index+1, or 0
+};
+
+// Hash a word using one of a family of hash functions selected by seed
+// This is FNV-1a followed by a final mix so that all the bits depend on every character.
+inline uint64_t hash(uint32_t seed, std::string_view word)
+{
+  uint64_t h{ 14695981039346656037ULL ^ (seed * 0x9E3779B97F4A7C15ULL) };
+  for (char ch : word) {
+    h ^= static_cast<unsigned char>(ch);
+    h *= 1099511628211ULL;
+  }
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDULL;
+  h ^= h >> 33;
+  return h;
+}
+
+// Get the size and last write time of the text file - returns false if it is not found
+inline bool source_identity(const std::string& file_name, uint64_t& size, int64_t& time)
+{
+  std::error_code error;
+  size = std::filesystem::file_size(file_name, error);
+  if (error)
+    return false;
+  time = std::filesystem::last_write_time(file_name, error).time_since_epoch().count();
+  return !error;
+}
+
+// Round n up to a multiple of 8 so every table is aligned
+inline uint64_t align(uint64_t n)
+{
+  return (n + 7) & ~uint64_t{ 7 };
+}
+} // namespace dictionary_index
+
+class Dictionary_Index {
+private:
+  Mapped_File file;
+  const dictionary_index::Header* header{};
+  const char* blob{};
+  const uint32_t* offsets{};
+  const int32_t* displacements{};
+  const uint32_t* slots{};
+  const uint32_t* group_words{};
+  const uint32_t* group_starts{};
+  const uint32_t* signatures{};
+
+  template <typename T>
+  const T* table(uint64_t offset) const
+  {
+    return reinterpret_cast<const T*>(file.data() + offset);
+  }
+
+  // Check the header and the table bounds against the size of the file, and the source
+  // identity against the text file
+  bool valid(const std::string& source_name) const
+  {
+    using namespace dictionary_index;
+    if (file.size() < sizeof(Header))
+      return false;
+    const Header& h{ *reinterpret_cast<const Header*>(file.data()) };
+    if (std::memcmp(h.magic, magic, sizeof(magic)) || h.version != version
+        || h.byte_order != byte_order || h.file_size != file.size())
+      return false;
+    uint64_t source_size{};
+    int64_t source_time{};
+    if (!source_identity(source_name, source_size, source_time)
+        || source_size != h.source_size || source_time != h.source_time)
+      return false; // The text file has changed or gone
+    auto fits = [&h](uint64_t offset, uint64_t bytes) {
+      return offset % 4 == 0 && offset <= h.file_size && bytes <= h.file_size - offset;
+    };
+    uint64_t words{ h.word_count };
+    return fits(h.blob_offset, h.blob_size)
+           && fits(h.offsets_offset, 4 * (words + 1))
+           && fits(h.displacements_offset, 4 * words) && fits(h.slots_offset, 4 * words)
+           && fits(h.group_words_offset, 4 * words)
+           && fits(h.group_starts_offset, 4 * (uint64_t{ h.group_count } + 1))
+           && fits(h.signatures_offset, 4 * uint64_t{ h.signature_slots })
+           && (h.signature_slots & (h.signature_slots - 1)) == 0
+           && h.group_count < h.signature_slots; // At least one empty slot ends a probe
+  }
+
+public:
+  static constexpr size_t npos{ static_cast<size_t>(-1) };
+
+  // Map an index file - it is only used if source_name is the text file it was compiled
+  // from and has not changed since
+  Dictionary_Index(const std::string& file_name, const std::string& source_name)
+    : file(file_name)
+  {
+    if (!file || !valid(source_name))
+      return;
+    header = table<dictionary_index::Header>(0);
+    blob = table<char>(header->blob_offset);
+    offsets = table<uint32_t>(header->offsets_offset);
+    displacements = table<int32_t>(header->displacements_offset);
+    slots = table<uint32_t>(header->slots_offset);
+    group_words = table<uint32_t>(header->group_words_offset);
+    group_starts = table<uint32_t>(header->group_starts_offset);
+    signatures = table<uint32_t>(header->signatures_offset);
+  }
+
+  // true if the file was opened and is a valid index
+  explicit operator bool() const { return header != nullptr; }
+
+  size_t size() const { return header ? header->word_count : 0; }
+
+  // Return word i in sorted order - an empty view if i or its offsets are out of range
+  std::string_view word(size_t i) const
+  {
+    if (i >= size() || offsets[i] >= offsets[i + 1] || offsets[i + 1] > header->blob_size)
+      return {};
+    return { blob + offsets[i], offsets[i + 1] - offsets[i] - 1 }; // Omit the newline
+  }
+
+  // Return the index of a word, or npos if it is not in the dictionary
+  size_t find(std::string_view word_in) const
+  {
+    size_t n{ size() };
+    if (!n)
+      return npos;
+    int32_t d{ displacements[dictionary_index::hash(0, word_in) % n] };
+    size_t slot{ d < 0 ? static_cast<size_t>(-(d + 1))
+                       : dictionary_index::hash(static_cast<uint32_t>(d), word_in) % n };
+    if (slot >= n)
+      return npos;
+    size_t index{ slots[slot] };
+    return !word_in.empty() && word(index) == word_in ? index : npos;
+  }
+
+  bool contains(std::string_view word_in) const { return find(word_in) != npos; }
+
+  // Return the dictionary words that are anagrams of a word, including the word itself
+  std::vector<std::string_view> anagrams(std::string_view word_in) const
+  {
+    std::vector<std::string_view> result;
+    if (!header || !header->signature_slots)
+      return result;
+    auto signature = Anagram_Index::signature(word_in);
+    size_t mask{ header->signature_slots - 1 };
+    size_t slot{ dictionary_index::hash(0, signature) & mask };
+    for (size_t probes{}; probes <= mask && signatures[slot];
+         ++probes, slot = (slot + 1) & mask) {
+      uint32_t group{ signatures[slot] - 1 };
+      if (group >= header->group_count)
+        break; // Damaged table
+      uint32_t first{ group_starts[group] }, last{ group_starts[group + 1] };
+      if (first >= last || last > header->word_count)
+        break;
+      if (Anagram_Index::signature(word(group_words[first])) != signature)
+        continue;
+      for (uint32_t i{ first }; i < last; ++i)
+        if (auto found = word(group_words[i]); !found.empty())
+          result.push_back(found);
+      break;
+    }
+    return result;
+  }
+};
+
+// Compile a dictionary that was read from the text file source_name into an index file
+// - returns false if the file is not written
+inline bool write_dictionary_index(const Mapped_Dictionary& dictionary,
+                                   const std::string& source_name,
+                                   const std::string& file_name)
+{
+  using namespace dictionary_index;
+  Header header{};
+  if (!source_identity(source_name, header.source_size, header.source_time))
+    return false;
+  std::vector<std::string_view> words{ std::begin(dictionary), std::end(dictionary) };
+  uint32_t n{ static_cast<uint32_t>(words.size()) };
+
+  // Words separated by newlines, and the offset of each word in the blob
+  std::string blob;
+  std::vector<uint32_t> offsets;
+  for (auto word : words) {
+    offsets.push_back(static_cast<uint32_t>(blob.size()));
+    blob.append(word.data(), word.size());
+    blob += '\n';
+  }
+  offsets.push_back(static_cast<uint32_t>(blob.size()));
+
+  // Perfect hash: place the words in the biggest buckets first, while most slots are
+  // empty, searching for a displacement that puts every word in a bucket in a free slot
+  std::vector<int32_t> displacements(n);
+  std::vector<uint32_t> slots(n);
+  std::vector<std::vector<uint32_t>> buckets(n);
+  for (uint32_t i{}; i < n; ++i)
+    buckets[hash(0, words[i]) % n].push_back(i);
+  std::vector<uint32_t> order(n);
+  for (uint32_t i{}; i < n; ++i)
+    order[i] = i;
+  std::sort(std::begin(order), std::end(order), [&buckets](uint32_t a, uint32_t b) {
+    return buckets[a].size() > buckets[b].size();
+  });
+  std::vector<bool> used(n);
+  size_t next_free{}; // Search for free slots for single words starts here
+  for (auto b : order) {
+    auto& bucket = buckets[b];
+    if (bucket.size() > 1) {
+      std::vector<size_t> trial;
+      for (uint32_t d{ 1 };; ++d) {
+        trial.clear();
+        for (auto i : bucket) {
+          size_t slot{ hash(d, words[i]) % n };
+          if (used[slot] || std::find(std::begin(trial), std::end(trial), slot)
+                              != std::end(trial))
+            break;
+          trial.push_back(slot);
+        }
+        if (trial.size() == bucket.size()) {
+          displacements[b] = static_cast<int32_t>(d);
+          break;
+        }
+      }
+      for (size_t j{}; j < bucket.size(); ++j) {
+        used[trial[j]] = true;
+        slots[trial[j]] = bucket[j];
+      }
+    } else if (bucket.size() == 1) {
+      while (used[next_free])
+        ++next_free;
+      used[next_free] = true;
+      slots[next_free] = bucket[0];
+      displacements[b] = -static_cast<int32_t>(next_free) - 1;
+    }
+  }
+
+  // Word indexes grouped by signature, with a hash table of the groups
+  Anagram_Index anagram_index{ words };
+  auto groups = anagram_index.anagram_groups(1);
+  std::vector<uint32_t> group_words, group_starts;
+  uint32_t signature_slots{ 16 };
+  while (signature_slots < 2 * groups.size())
+    signature_slots *= 2;
+  std::vector<uint32_t> signatures(signature_slots);
+  for (uint32_t g{}; g < groups.size(); ++g) {
+    group_starts.push_back(static_cast<uint32_t>(group_words.size()));
+    for (auto word : *groups[g])
+      group_words.push_back(static_cast<uint32_t>(
+        std::lower_bound(std::begin(words), std::end(words), word) - std::begin(words)));
+    auto slot = hash(0, Anagram_Index::signature(groups[g]->front()))
+                & (signature_slots - 1);
+    while (signatures[slot])
+      slot = (slot + 1) & (signature_slots - 1);
+    signatures[slot] = g + 1;
+  }
+  group_starts.push_back(static_cast<uint32_t>(group_words.size()));
+
+  // Lay out the file
+  std::memcpy(header.magic, magic, sizeof(magic));
+  header.version = version;
+  header.byte_order = byte_order;
+  header.word_count = n;
+  header.group_count = static_cast<uint32_t>(groups.size());
+  header.signature_slots = signature_slots;
+  header.blob_offset = align(sizeof(Header));
+  header.blob_size = blob.size();
+  header.offsets_offset = align(header.blob_offset + blob.size());
+  header.displacements_offset = align(header.offsets_offset + 4 * offsets.size());
+  header.slots_offset = align(header.displacements_offset + 4 * displacements.size());
+  header.group_words_offset = align(header.slots_offset + 4 * slots.size());
+  header.group_starts_offset = align(header.group_words_offset + 4 * group_words.size());
+  header.signatures_offset = align(header.group_starts_offset + 4 * group_starts.size());
+  header.file_size = header.signatures_offset + 4 * signatures.size();
+
+  std::ofstream out{ file_name,
+                     std::ios_base::out | std::ios_base::trunc | std::ios_base::binary };
+  auto write_at = [&out](uint64_t offset, const void* data, size_t bytes) {
+    while (static_cast<uint64_t>(out.tellp()) < offset) // Padding
+      out.put('\0');
+    out.write(static_cast<const char*>(data), bytes);
+  };
+  write_at(0, &header, sizeof(header));
+  write_at(header.blob_offset, blob.data(), blob.size());
+  write_at(header.offsets_offset, offsets.data(), 4 * offsets.size());
+  write_at(header.displacements_offset, displacements.data(), 4 * displacements.size());
+  write_at(header.slots_offset, slots.data(), 4 * slots.size());
+  write_at(header.group_words_offset, group_words.data(), 4 * group_words.size());
+  write_at(header.group_starts_offset, group_starts.data(), 4 * group_starts.size());
+  write_at(header.signatures_offset, signatures.data(), 4 * signatures.size());
+  return static_cast<bool>(out);
+}
+#endif
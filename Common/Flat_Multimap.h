@@ -0,0 +1,374 @@
+// Flat_Multimap.h
+// An unordered multimap that uses open addressing instead of linked nodes
+// The elements are stored contiguously in a vector. The hash table is two arrays with
+// one entry per slot: a control byte that is empty, deleted, or holds 7 bits of the
+// hash of the key in the slot, and the index of the element in the vector. A lookup
+// probes consecutive control bytes, which share cache lines, and compares a key only
+// when the 7 hash bits match, so a lookup typically touches one line of control bytes
+// and the element itself. Inserting allocates nothing except when a vector grows.
+//
+// Elements with equal keys are all in the probe sequence that starts at the home slot
+// of the key, which ends at an empty slot, so equal_range() returns iterators that step
+// along the probe sequence visiting only the slots with an equal key. Erasing marks the
+// slot deleted and moves the last element into the gap in the vector, updating the
+// slot that refers to it, so iterators, which refer to slots, stay valid when other
+// elements are erased. Keys must not be changed through an iterator. The table doubles
+// when more than the maximum load factor of the slots, 7/8 by default, would be used.
+
+#ifndef FLAT_MULTIMAP_H
+#define FLAT_MULTIMAP_H
+
+#include <algorithm>  // For min()
+#include <cstddef>    // For size_t, ptrdiff_t
+#include <cstdint>    // For fixed width integer types
+#include <functional> // For hash, equal_to
+#include <iterator>   // For iterator tags, distance()
+#include <utility>    // For pair, forward(), move()
+#include <vector>     // For vector container
+
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class Flat_Multimap {
+public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+  using size_type = size_t;
+
+private:
+  static constexpr uint8_t empty_slot{ 0x80 };   // Slot has never been used
+  static constexpr uint8_t deleted_slot{ 0xFE }; // Slot held an element that was erased
+  // Any other value is the low 7 bits of the hash of the key in a used slot
+
+  std::vector<value_type> elements;
+  std::vector<uint8_t> control;  // One byte per slot: empty, deleted, or hash bits
+  std::vector<uint32_t> indexes; // Index in elements of the element in each slot
+  size_t mask{};                 // Number of slots - 1
+  size_t tombstones{};           // Number of deleted slots
+  float max_load{ 0.875f };      // Maximum fraction of slots used or deleted
+  size_t max_used{};             // Slots that can be used before the table grows
+  Hash hasher;
+  KeyEqual equal;
+
+  static uint8_t tag(size_t hash) { return static_cast<uint8_t>(hash & 0x7F); }
+  static bool is_used(uint8_t control_byte) { return control_byte < 0x80; }
+  size_t home(size_t hash) const { return (hash >> 7) & mask; }
+  size_t next(size_t slot) const { return (slot + 1) & mask; }
+
+  // Mark a slot unused - it can be empty if the next slot is, as no probe passes it
+  void release(size_t slot)
+  {
+    if (control[next(slot)] == empty_slot) {
+      control[slot] = empty_slot;
+    } else {
+      control[slot] = deleted_slot;
+      ++tombstones;
+    }
+  }
+
+  // The slot that refers to an element
+  size_t slot_of(size_t index) const
+  {
+    size_t slot{ home(hasher(elements[index].first)) };
+    while (!is_used(control[slot]) || indexes[slot] != index)
+      slot = next(slot);
+    return slot;
+  }
+
+  // Make a table of n slots, which must be a power of 2, for the current elements
+  void rehash_slots(size_t n)
+  {
+    control.assign(n, empty_slot);
+    indexes.assign(n, 0);
+    mask = n - 1;
+    tombstones = 0;
+    set_max_used();
+    for (size_t i{}; i < elements.size(); ++i) {
+      size_t hash{ hasher(elements[i].first) };
+      size_t slot{ home(hash) };
+      while (control[slot] != empty_slot)
+        slot = next(slot);
+      control[slot] = tag(hash);
+      indexes[slot] = static_cast<uint32_t>(i);
+    }
+  }
+
+  // At least one slot must stay empty so every probe sequence ends
+  void set_max_used()
+  {
+    max_used = static_cast<size_t>(max_load * control.size());
+    max_used = std::min(max_used, control.size() - 1);
+  }
+
+  // The number of slots needed for n elements to use no more than a fraction of them
+  size_t slots_for(size_t n, float fraction) const
+  {
+    size_t slots{ 16 };
+    while (n > fraction * slots || n >= slots)
+      slots *= 2;
+    return slots;
+  }
+
+  // Make sure there is room for one more element
+  void make_room()
+  {
+    if (elements.size() + tombstones + 1 <= max_used)
+      return;
+    // Double the table, unless removing the deleted slots frees more than half of them
+    bool grow{ 2 * (elements.size() + 1) > max_used };
+    rehash_slots(grow ? 2 * control.size() : control.size());
+  }
+
+  // Step along the probe sequence from slot to the next slot holding the key
+  size_t find_slot(size_t slot, const Key& key, uint8_t key_tag) const
+  {
+    for (; control[slot] != empty_slot; slot = next(slot))
+      if (control[slot] == key_tag && equal(elements[indexes[slot]].first, key))
+        return slot;
+    return npos;
+  }
+
+public:
+  static constexpr size_t npos{ static_cast<size_t>(-1) };
+
+  // Iterates over all the elements in slot order
+  class const_iterator {
+  private:
+    const Flat_Multimap* map{};
+    size_t slot{};
+
+    void skip_unused()
+    {
+      while (slot < map->control.size() && !is_used(map->control[slot]))
+        ++slot;
+    }
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Flat_Multimap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    const_iterator() = default;
+    const_iterator(const Flat_Multimap* m, size_t s)
+      : map(m)
+      , slot(s)
+    {
+      skip_unused();
+    }
+
+    reference operator*() const { return map->elements[map->indexes[slot]]; }
+    pointer operator->() const { return &**this; }
+    const_iterator& operator++()
+    {
+      ++slot;
+      skip_unused();
+      return *this;
+    }
+    const_iterator operator++(int)
+    {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+    bool operator==(const const_iterator& other) const { return slot == other.slot; }
+    bool operator!=(const const_iterator& other) const { return slot != other.slot; }
+    size_t position() const { return slot; }
+  };
+  using iterator = const_iterator;
+
+  // Iterates over the elements with one key - the end iterator has slot npos
+  class const_range_iterator {
+  private:
+    const Flat_Multimap* map{};
+    size_t slot{ npos };
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Flat_Multimap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    const_range_iterator() = default;
+    const_range_iterator(const Flat_Multimap* m, size_t s)
+      : map(m)
+      , slot(s)
+    {
+    }
+
+    reference operator*() const { return map->elements[map->indexes[slot]]; }
+    pointer operator->() const { return &**this; }
+    const_range_iterator& operator++() // The key of this element finds the next one
+    {
+      const auto& key = (**this).first;
+      slot = map->find_slot(map->next(slot), key, map->control[slot]);
+      return *this;
+    }
+    const_range_iterator operator++(int)
+    {
+      auto copy = *this;
+      ++*this;
+      return copy;
+    }
+    bool operator==(const const_range_iterator& other) const
+    {
+      return slot == other.slot;
+    }
+    bool operator!=(const const_range_iterator& other) const
+    {
+      return slot != other.slot;
+    }
+    size_t position() const { return slot; }
+  };
+  using range_iterator = const_range_iterator;
+
+  explicit Flat_Multimap(size_t n = 8, const Hash& hash = Hash(),
+                         const KeyEqual& key_equal = KeyEqual())
+    : hasher(hash)
+    , equal(key_equal)
+  {
+    reserve(n);
+  }
+
+  size_t size() const { return elements.size(); }
+  bool empty() const { return elements.empty(); }
+  size_t slot_count() const { return control.size(); }
+  Hash hash_function() const { return hasher; }
+  float load_factor() const { return static_cast<float>(size()) / control.size(); }
+  float max_load_factor() const { return max_load; }
+
+  // Set the maximum fraction of slots used before the table grows - less than 1
+  void max_load_factor(float fraction)
+  {
+    max_load = fraction;
+    set_max_used();
+    if (elements.size() + tombstones > max_used)
+      rehash_slots(slots_for(elements.size(), max_load));
+  }
+
+  // true if a slot has never held an element since the last rehash - a probe stops there
+  bool slot_empty(size_t slot) const { return control[slot] == empty_slot; }
+
+  // Number of slots a lookup examines to reach an element
+  size_t probe_length(const_iterator iter) const
+  {
+    size_t slot{ iter.position() };
+    return ((slot - home(hasher(elements[indexes[slot]].first))) & mask) + 1;
+  }
+
+  const_iterator begin() const { return const_iterator{ this, 0 }; }
+  const_iterator end() const { return const_iterator{ this, control.size() }; }
+
+  // Make room for n elements without reallocating
+  void reserve(size_t n)
+  {
+    elements.reserve(n);
+    size_t slots{ slots_for(n, max_load) };
+    if (slots > control.size())
+      rehash_slots(slots);
+  }
+
+  template <typename K, typename M>
+  const_iterator emplace(K&& key, M&& mapped)
+  {
+    make_room();
+    elements.emplace_back(std::forward<K>(key), std::forward<M>(mapped));
+    size_t hash{ hasher(elements.back().first) };
+    size_t slot{ home(hash) };
+    while (is_used(control[slot]))
+      slot = next(slot);
+    if (control[slot] == deleted_slot)
+      --tombstones;
+    control[slot] = tag(hash);
+    indexes[slot] = static_cast<uint32_t>(elements.size() - 1);
+    return const_iterator{ this, slot };
+  }
+
+  const_iterator insert(const value_type& value)
+  {
+    return emplace(value.first, value.second);
+  }
+
+  std::pair<const_range_iterator, const_range_iterator> equal_range(const Key& key) const
+  {
+    size_t hash{ hasher(key) };
+    return { const_range_iterator{ this, find_slot(home(hash), key, tag(hash)) },
+             const_range_iterator{ this, npos } };
+  }
+
+  const_iterator find(const Key& key) const
+  {
+    size_t hash{ hasher(key) };
+    size_t slot{ find_slot(home(hash), key, tag(hash)) };
+    return slot == npos ? end() : const_iterator{ this, slot };
+  }
+
+  size_t count(const Key& key) const
+  {
+    auto range = equal_range(key);
+    return static_cast<size_t>(std::distance(range.first, range.second));
+  }
+
+  // Erase the element in a slot
+  void erase_slot(size_t slot)
+  {
+    size_t index{ indexes[slot] };
+    size_t last{ elements.size() - 1 };
+    if (index != last) { // Move the last element into the gap
+      size_t last_slot{ slot_of(last) };
+      elements[index] = std::move(elements[last]);
+      indexes[last_slot] = static_cast<uint32_t>(index);
+    }
+    elements.pop_back();
+    release(slot);
+  }
+
+  // Erase an element - returns an iterator to the next element with the same key
+  const_range_iterator erase(const_range_iterator iter)
+  {
+    auto next_iter = std::next(iter);
+    erase_slot(iter.position());
+    return next_iter;
+  }
+
+  const_range_iterator erase(const_range_iterator first, const_range_iterator last)
+  {
+    while (first != last)
+      first = erase(first);
+    return last;
+  }
+
+  const_iterator erase(const_iterator iter)
+  {
+    auto next_iter = std::next(iter);
+    erase_slot(iter.position());
+    return next_iter;
+  }
+
+  // Erase all the elements with a key - returns the number erased
+  size_t erase(const Key& key)
+  {
+    size_t erased{};
+    for (auto range = equal_range(key); range.first != range.second; ++erased)
+      range.first = erase(range.first);
+    return erased;
+  }
+
+  void clear()
+  {
+    elements.clear();
+    control.assign(control.size(), empty_slot);
+    tombstones = 0;
+  }
+
+  // Bytes allocated for the table and the elements, not including memory the elements
+  // allocate themselves
+  size_t memory() const
+  {
+    return elements.capacity() * sizeof(value_type)
+           + control.size() * (sizeof(uint8_t) + sizeof(uint32_t));
+  }
+};
+#endif
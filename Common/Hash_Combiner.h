@@ -0,0 +1,106 @@
+// Hash_Combiner.h
+// Computes a 64-bit hash of a sequence of fields without building a combined key
+// Each field is fed to the combiner in turn, so a hash function object for a type with
+// several members can hash them where they are, without concatenating them into a
+// temporary string that may allocate. The bytes of a field are read 8 at a time and
+// mixed into the state by a 64x64 to 128-bit multiply whose two halves are combined,
+// in the same way as the wyhash function. The length of each field is mixed in too, so
+// moving characters from one field to the next changes the hash - "ab" + "c" and
+// "a" + "bc" hash differently, which they do not when the fields are concatenated.
+// Hash values depend on the byte order of the processor, so they must not be stored.
+
+#ifndef HASH_COMBINER_H
+#define HASH_COMBINER_H
+
+#include <cstddef>     // For size_t
+#include <cstdint>     // For fixed width integer types
+#include <cstring>     // For memcpy()
+#include <string_view> // For string_view
+
+class Hash_Combiner {
+private:
+  static constexpr uint64_t secret[4]{ 0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL,
+                                       0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL };
+  uint64_t state;
+
+  // Multiply to 128 bits and combine the high and low halves
+  static uint64_t mix(uint64_t a, uint64_t b)
+  {
+#if defined(__SIZEOF_INT128__)
+    unsigned __int128 product{ static_cast<unsigned __int128>(a) * b };
+    return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+#else
+    uint64_t a_lo{ a & 0xFFFFFFFF }, a_hi{ a >> 32 };
+    uint64_t b_lo{ b & 0xFFFFFFFF }, b_hi{ b >> 32 };
+    uint64_t lo_lo{ a_lo * b_lo }, hi_lo{ a_hi * b_lo }, lo_hi{ a_lo * b_hi };
+    uint64_t middle{ (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi };
+    uint64_t low{ (middle << 32) | (lo_lo & 0xFFFFFFFF) };
+    uint64_t high{ a_hi * b_hi + (hi_lo >> 32) + (middle >> 32) };
+    return low ^ high;
+#endif
+  }
+
+  // Unaligned reads - memcpy() compiles to a single load
+  static uint64_t read64(const unsigned char* p)
+  {
+    uint64_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+  }
+  static uint64_t read32(const unsigned char* p)
+  {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+  }
+
+public:
+  explicit Hash_Combiner(uint64_t seed = 0)
+    : state(seed ^ secret[0])
+  {
+  }
+
+  // Add n bytes starting at data
+  Hash_Combiner& add(const void* data, size_t n)
+  {
+    auto p = static_cast<const unsigned char*>(data);
+    uint64_t a{}, b{};
+    if (n <= 16) { // Two overlapping reads from each end cover up to 16 bytes
+      if (n >= 4) {
+        size_t offset{ (n >> 3) << 2 }; // 4 if there are at least 8 bytes, else 0
+        a = (read32(p) << 32) | read32(p + offset);
+        b = (read32(p + n - 4) << 32) | read32(p + n - 4 - offset);
+      } else if (n > 0) {
+        a = (uint64_t{ p[0] } << 16) | (uint64_t{ p[n >> 1] } << 8) | p[n - 1];
+      }
+    } else {
+      size_t left{ n };
+      for (; left > 16; left -= 16, p += 16)
+        state = mix(read64(p) ^ secret[1], read64(p + 8) ^ state);
+      a = read64(p + left - 16); // The last 16 bytes, which may overlap the ones before
+      b = read64(p + left - 8);
+    }
+    state = mix(a ^ secret[1], b ^ state) ^ n;
+    return *this;
+  }
+
+  Hash_Combiner& add(std::string_view text) { return add(text.data(), text.size()); }
+
+  Hash_Combiner& add(uint64_t value)
+  {
+    state = mix(value ^ secret[2], state ^ secret[1]);
+    return *this;
+  }
+
+  uint64_t value() const { return mix(state ^ secret[2], secret[3]); }
+};
+
+// Hash any number of fields, each a string or an integer
+template <typename... Fields>
+inline size_t hash_fields(const Fields&... fields)
+{
+  Hash_Combiner combiner;
+  (combiner.add(fields), ...);
+  return static_cast<size_t>(combiner.value());
+}
+#endif
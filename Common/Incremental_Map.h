@@ -0,0 +1,284 @@
+// Incremental_Map.h
+// An unordered map that rehashes a little at a time so no single operation is slow
+// When an unordered_map grows it moves every element to the new buckets in the insert
+// that exceeds the maximum load factor, which takes milliseconds for a large map. This
+// map uses chaining too, but when it grows it keeps the old bucket array alongside one
+// twice the size, and each later insert or lookup moves the chains of the next few old
+// buckets to the new array. The elements of old bucket i go to new buckets i and i + m,
+// where m is the old number of buckets, so until bucket i has been moved, elements that
+// hash to it are found in and added to the old array. Every operation therefore looks
+// in just one chain, and the new array needs no clearing when it is allocated - its
+// buckets are cleared as the old buckets are moved into them. Nodes keep the hash of
+// their key so moving them calls no hash function. Lookups change the map, so find()
+// is not const.
+
+#ifndef INCREMENTAL_MAP_H
+#define INCREMENTAL_MAP_H
+
+#include <cmath>      // For ceil()
+#include <cstddef>    // For size_t
+#include <cstdlib>    // For malloc(), free()
+#include <functional> // For hash, equal_to
+#include <new>        // For bad_alloc
+#include <utility>    // For pair, forward(), move()
+
+template <typename Key, typename T, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class Incremental_Map {
+public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using size_type = size_t;
+
+private:
+  struct Node {
+    Node* next;
+    size_t hash;
+    value_type value;
+  };
+
+  // An array of chains - the number of buckets is a power of 2
+  struct Buckets {
+    Node** heads{};
+    size_t count{};
+
+    size_t index(size_t hash) const { return hash & (count - 1); }
+  };
+
+  static const size_t lookup_steps{ 1 }; // Old buckets moved by each lookup
+
+  Buckets buckets;          // The current buckets
+  Buckets old_buckets;      // Buckets being moved during a rehash - none otherwise
+  size_t next_old{};        // Index of the next old bucket to move
+  size_t insert_steps{ 2 }; // Old buckets moved by each insert
+  size_t n_elements{};
+  float max_load{ 1.0f };
+  Hash hasher;
+  KeyEqual equal;
+
+  // Allocate buckets that are not cleared
+  static Buckets allocate(size_t count)
+  {
+    auto heads = static_cast<Node**>(std::malloc(count * sizeof(Node*)));
+    if (!heads)
+      throw std::bad_alloc{};
+    return { heads, count };
+  }
+
+  bool rehashing() const { return old_buckets.heads != nullptr; }
+
+  // true if a new bucket is in use - during a rehash, only once its old bucket has moved
+  bool in_use(size_t bucket) const
+  {
+    return !rehashing() || (bucket & (old_buckets.count - 1)) < next_old;
+  }
+
+  // The chain that holds a hash
+  Node*& chain(size_t hash)
+  {
+    if (rehashing()) {
+      size_t old{ old_buckets.index(hash) };
+      if (old >= next_old)
+        return old_buckets.heads[old];
+    }
+    return buckets.heads[buckets.index(hash)];
+  }
+
+  // Move the chains of up to steps old buckets to the new buckets
+  void move_buckets(size_t steps)
+  {
+    for (; steps && rehashing(); --steps, ++next_old) {
+      if (next_old == old_buckets.count) { // All moved
+        std::free(old_buckets.heads);
+        old_buckets = Buckets{};
+        next_old = 0;
+        return;
+      }
+      buckets.heads[next_old] = buckets.heads[next_old + old_buckets.count] = nullptr;
+      for (Node* node{ old_buckets.heads[next_old] }; node;) {
+        Node* next{ node->next };
+        Node*& head = buckets.heads[buckets.index(node->hash)];
+        node->next = head;
+        head = node;
+        node = next;
+      }
+    }
+  }
+
+  // Start a rehash into twice as many buckets - any rehash in progress is finished first
+  void grow()
+  {
+    finish_rehash();
+    auto new_buckets = allocate(2 * buckets.count);
+    old_buckets = buckets;
+    buckets = new_buckets;
+    next_old = 0;
+  }
+
+  // Find the link that points to the node for a key - nullptr if there is none
+  Node** find_link(const Key& key, size_t hash)
+  {
+    for (Node** link{ &chain(hash) }; *link; link = &(*link)->next)
+      if ((*link)->hash == hash && equal((*link)->value.first, key))
+        return link;
+    return nullptr;
+  }
+
+  template <typename K, typename M>
+  std::pair<T*, bool> emplace_key(K&& key, M&& mapped)
+  {
+    move_buckets(insert_steps);
+    size_t hash{ hasher(key) };
+    if (Node** link{ find_link(key, hash) })
+      return { &(*link)->value.second, false };
+    if (n_elements + 1 > max_load * buckets.count)
+      grow();
+    Node*& head = chain(hash);
+    head = new Node{ head, hash,
+                     value_type(std::forward<K>(key), std::forward<M>(mapped)) };
+    ++n_elements;
+    return { &head->value.second, true };
+  }
+
+  // Call f for the first node of every chain that is in use
+  template <typename F>
+  void for_each_chain(F f) const
+  {
+    for (size_t i{ next_old }; i < old_buckets.count; ++i)
+      f(old_buckets.heads[i]);
+    for (size_t i{}; i < buckets.count; ++i)
+      if (in_use(i))
+        f(buckets.heads[i]);
+  }
+
+  void destroy()
+  {
+    for_each_chain([](Node* node) {
+      while (node) {
+        Node* next{ node->next };
+        delete node;
+        node = next;
+      }
+    });
+    std::free(buckets.heads);
+    std::free(old_buckets.heads);
+    buckets = old_buckets = Buckets{};
+    next_old = n_elements = 0;
+  }
+
+  void make_buckets(size_t count)
+  {
+    buckets = allocate(count);
+    for (size_t i{}; i < count; ++i)
+      buckets.heads[i] = nullptr;
+  }
+
+public:
+  explicit Incremental_Map(size_t n = 8, const Hash& hash = Hash(),
+                           const KeyEqual& key_equal = KeyEqual())
+    : hasher(hash)
+    , equal(key_equal)
+  {
+    size_t count{ 8 };
+    while (n > max_load * count)
+      count *= 2;
+    make_buckets(count);
+  }
+
+  ~Incremental_Map() { destroy(); }
+
+  Incremental_Map(const Incremental_Map&) = delete;
+  Incremental_Map& operator=(const Incremental_Map&) = delete;
+
+  size_t size() const { return n_elements; }
+  bool empty() const { return n_elements == 0; }
+  size_t bucket_count() const { return buckets.count; }
+  float load_factor() const { return static_cast<float>(n_elements) / buckets.count; }
+  float max_load_factor() const { return max_load; }
+  Hash hash_function() const { return hasher; }
+  bool rehash_in_progress() const { return rehashing(); }
+
+  // Set the maximum load factor - inserts move enough old buckets to finish a rehash
+  // before the new buckets reach it
+  void max_load_factor(float load)
+  {
+    max_load = load;
+    insert_steps = 1 + static_cast<size_t>(std::ceil(1.0f / load));
+  }
+
+  // Number of elements in a bucket - only complete when no rehash is in progress
+  size_t bucket_size(size_t bucket) const
+  {
+    size_t count{};
+    if (in_use(bucket))
+      for (Node* node{ buckets.heads[bucket] }; node; node = node->next)
+        ++count;
+    return count;
+  }
+
+  // Move all the elements that remain in the old buckets
+  void finish_rehash()
+  {
+    if (rehashing())
+      move_buckets(old_buckets.count - next_old + 1);
+  }
+
+  // Insert an element if there is none with the key - returns a pointer to the value
+  // for the key, and true if it was inserted
+  template <typename M>
+  std::pair<T*, bool> emplace(const Key& key, M&& mapped)
+  {
+    return emplace_key(key, std::forward<M>(mapped));
+  }
+
+  template <typename M>
+  std::pair<T*, bool> emplace(Key&& key, M&& mapped)
+  {
+    return emplace_key(std::move(key), std::forward<M>(mapped));
+  }
+
+  T& operator[](const Key& key) { return *emplace(key, T{}).first; }
+
+  // Returns a pointer to the value for a key, or nullptr if there is none
+  T* find(const Key& key)
+  {
+    move_buckets(lookup_steps);
+    Node** link{ find_link(key, hasher(key)) };
+    return link ? &(*link)->value.second : nullptr;
+  }
+
+  bool contains(const Key& key) { return find(key) != nullptr; }
+
+  // Erase the element with a key - returns the number erased
+  size_t erase(const Key& key)
+  {
+    move_buckets(lookup_steps);
+    Node** link{ find_link(key, hasher(key)) };
+    if (!link)
+      return 0;
+    Node* node{ *link };
+    *link = node->next;
+    delete node;
+    --n_elements;
+    return 1;
+  }
+
+  // Call f for every element
+  template <typename F>
+  void for_each(F f) const
+  {
+    for_each_chain([&f](const Node* node) {
+      for (; node; node = node->next)
+        f(node->value);
+    });
+  }
+
+  void clear()
+  {
+    size_t count{ buckets.count };
+    destroy();
+    make_buckets(count);
+  }
+};
+#endif
@@ -0,0 +1,115 @@
+// Mapped_Dictionary.h
+// A dictionary of words read from a memory-mapped text file without copying them
+// The file is mapped into memory and divided into words separated by whitespace. Each
+// word is a string_view referring to the mapped file, so loading the dictionary makes
+// two allocations - the array of words and the hash table - rather than one for every
+// word. The words are sorted and duplicates removed, so a word can be found by binary
+// search. An open-addressing hash table of indexes into the array finds a word with
+// one probe on average.
+
+#ifndef MAPPED_DICTIONARY_H
+#define MAPPED_DICTIONARY_H
+
+#include <algorithm>   // For sort(), unique(), is_sorted(), binary_search()
+#include <cctype>      // For isspace()
+#include <cstdint>     // For uint32_t, uint64_t
+#include <string>      // For string class
+#include <string_view> // For string_view
+#include <vector>      // For vector container
+
+#include "Mapped_File.h"
+
+class Mapped_Dictionary {
+private:
+  Mapped_File file;
+  std::vector<std::string_view> words; // Sorted words in the file
+  std::vector<uint32_t> table;         // Index of a word + 1 in words, or 0 if empty
+  size_t mask{};                       // Table size - 1
+
+  static bool is_space(char ch) { return std::isspace(static_cast<unsigned char>(ch)); }
+
+  void build_table()
+  {
+    size_t size{ 16 };
+    while (size < 2 * words.size()) // No more than half full
+      size *= 2;
+    table.assign(size, 0);
+    mask = size - 1;
+    for (size_t i{}; i < words.size(); ++i) {
+      size_t slot{ hash(words[i]) & mask };
+      while (table[slot])
+        slot = (slot + 1) & mask;
+      table[slot] = static_cast<uint32_t>(i + 1);
+    }
+  }
+
+public:
+  explicit Mapped_Dictionary(const std::string& file_name)
+    : file(file_name)
+  {
+    if (!file)
+      return;
+    file.sequential();
+    size_t estimate{ file.size() / 8 }; // Guess at the number of words to reserve space
+    words.reserve(estimate);
+    const char* first{ file.begin() };
+    const char* last{ file.end() };
+    while (true) {
+      while (first != last && is_space(*first))
+        ++first;
+      if (first == last)
+        break;
+      const char* start{ first };
+      while (first != last && !is_space(*first))
+        ++first;
+      words.emplace_back(start, static_cast<size_t>(first - start));
+    }
+    if (!std::is_sorted(std::begin(words), std::end(words))) // Usually it is
+      std::sort(std::begin(words), std::end(words));
+    words.erase(std::unique(std::begin(words), std::end(words)), std::end(words));
+    words.shrink_to_fit();
+    build_table();
+  }
+
+  // FNV-1a hash of a word
+  static uint64_t hash(std::string_view word)
+  {
+    uint64_t h{ 14695981039346656037ULL };
+    for (char ch : word) {
+      h ^= static_cast<unsigned char>(ch);
+      h *= 1099511628211ULL;
+    }
+    return h;
+  }
+
+  explicit operator bool() const { return static_cast<bool>(file); }
+
+  size_t size() const { return words.size(); }
+  auto begin() const { return std::begin(words); }
+  auto end() const { return std::end(words); }
+  std::string_view operator[](size_t i) const { return words[i]; }
+
+  // Find a word using the hash table
+  bool contains(std::string_view word) const
+  {
+    if (table.empty())
+      return false;
+    for (size_t slot{ hash(word) & mask }; table[slot]; slot = (slot + 1) & mask)
+      if (words[table[slot] - 1] == word)
+        return true;
+    return false;
+  }
+
+  // Find a word by binary search
+  bool binary_search(std::string_view word) const
+  {
+    return std::binary_search(std::begin(words), std::end(words), word);
+  }
+
+  // Bytes allocated for the dictionary, excluding the mapped file
+  size_t memory() const
+  {
+    return words.capacity() * sizeof(std::string_view) + table.size() * sizeof(uint32_t);
+  }
+};
+#endif
@@ -0,0 +1,120 @@
+// Mapped_File.h
+// Maps the contents of a file into memory
+// On POSIX systems the file is mapped with mmap(), so the contents are paged in on
+// demand and nothing is copied. Elsewhere the file is read into a buffer. Either way
+// the object is used like a stream object: test it before use to see if it opened.
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>  // For size_t
+#include <fstream>  // For file streams
+#include <iterator> // For istreambuf_iterator
+#include <string>   // For string class
+#include <utility>  // For exchange(), swap()
+#include <vector>   // For vector container
+
+#if defined(__unix__) || defined(__APPLE__)
+#define MAPPED_FILE_USE_MMAP 1
+#include <fcntl.h>    // For open()
+#include <sys/mman.h> // For mmap(), munmap(), madvise()
+#include <sys/stat.h> // For fstat()
+#include <unistd.h>   // For close()
+#endif
+
+class Mapped_File {
+public:
+  enum class Mode {
+    read_only,    // Contents can only be read
+    copy_on_write // Contents can be modified - changes are not written to the file
+  };
+
+private:
+  char* contents{};         // Start of the file contents
+  size_t length{};          // Number of bytes in the file
+  bool open{};              // true if the file was opened
+  std::vector<char> buffer; // File contents when mmap() is not available
+
+public:
+  Mapped_File() = default;
+
+  explicit Mapped_File(const std::string& file_name, Mode mode = Mode::read_only)
+  {
+#ifdef MAPPED_FILE_USE_MMAP
+    int fd{ ::open(file_name.c_str(), O_RDONLY) };
+    if (fd < 0)
+      return;
+    struct stat info {};
+    if (::fstat(fd, &info) == 0) {
+      length = static_cast<size_t>(info.st_size);
+      open = true;
+      if (length) { // An empty file cannot be mapped
+        int protection{ mode == Mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE };
+        void* addr{ ::mmap(nullptr, length, protection, MAP_PRIVATE, fd, 0) };
+        if (addr == MAP_FAILED) {
+          length = 0;
+          open = false;
+        } else
+          contents = static_cast<char*>(addr);
+      }
+    }
+    ::close(fd); // The mapping stays valid after the file is closed
+#else
+    std::ifstream in{ file_name, std::ios_base::in | std::ios_base::binary };
+    if (!in)
+      return;
+    buffer.assign(std::istreambuf_iterator<char>{ in }, std::istreambuf_iterator<char>{});
+    contents = buffer.data();
+    length = buffer.size();
+    open = true;
+    (void)mode;
+#endif
+  }
+
+  ~Mapped_File()
+  {
+#ifdef MAPPED_FILE_USE_MMAP
+    if (contents)
+      ::munmap(contents, length);
+#endif
+  }
+
+  Mapped_File(const Mapped_File&) = delete;
+  Mapped_File& operator=(const Mapped_File&) = delete;
+
+  Mapped_File(Mapped_File&& other) noexcept
+    : contents(std::exchange(other.contents, nullptr))
+    , length(std::exchange(other.length, 0))
+    , open(std::exchange(other.open, false))
+    , buffer(std::move(other.buffer))
+  {
+  }
+
+  Mapped_File& operator=(Mapped_File&& other) noexcept
+  {
+    Mapped_File moved{ std::move(other) };
+    std::swap(contents, moved.contents);
+    std::swap(length, moved.length);
+    std::swap(open, moved.open);
+    std::swap(buffer, moved.buffer);
+    return *this;
+  }
+
+  explicit operator bool() const { return open; }
+
+  const char* data() const { return contents; }
+  char* data() { return contents; } // Only writable in copy_on_write mode
+  size_t size() const { return length; }
+  const char* begin() const { return contents; }
+  const char* end() const { return contents + length; }
+
+  // Tell the system the contents will be read from beginning to end
+  void sequential() const
+  {
+#ifdef MAPPED_FILE_USE_MMAP
+    if (contents)
+      ::madvise(contents, length, MADV_SEQUENTIAL);
+#endif
+  }
+};
+#endif
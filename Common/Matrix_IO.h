@@ -0,0 +1,192 @@
+// Matrix_IO.h
+// Loading and saving the coefficients for a set of linear equations
+// A set of n equations is stored as n rows of n+1 elements, the last element in each
+// row being the right-hand side. There are two file formats:
+// Text:   n followed by the n*(n+1) values separated by whitespace - this is the
+//         sequence of values that is entered from the keyboard.
+// Binary: a 16 byte header - the 8 characters "STLMAT01" then n as a 64-bit
+//         little-endian integer - followed by the values as little-endian doubles.
+//         A binary file can be mapped into memory and the values used in place.
+
+#ifndef MATRIX_IO_H
+#define MATRIX_IO_H
+
+#include <algorithm>    // For reverse()
+#include <cctype>       // For isspace()
+#include <charconv>     // For from_chars()
+#include <cstdint>      // For uint64_t, SIZE_MAX
+#include <cstring>      // For memcmp(), memcpy()
+#include <fstream>      // For file streams
+#include <iomanip>      // For setprecision()
+#include <istream>      // For istream class
+#include <limits>       // For numeric_limits
+#include <string>       // For string class
+#include <system_error> // For errc
+#include <valarray>     // For valarray
+
+#include "Mapped_File.h"
+
+namespace matrix_io {
+const char magic[8]{ 'S', 'T', 'L', 'M', 'A', 'T', '0', '1' }; // Binary file identifier
+const size_t header_size{ 16 };                                  // Bytes before the data
+
+inline bool little_endian()
+{
+  const uint16_t probe{ 1 };
+  return *reinterpret_cast<const unsigned char*>(&probe) == 1;
+}
+
+// Reverse the bytes in each object in a range to convert between byte orders
+template <typename T>
+void reverse_bytes(T* first, size_t count)
+{
+  for (size_t i{}; i < count; ++i) {
+    auto bytes = reinterpret_cast<unsigned char*>(first + i);
+    std::reverse(bytes, bytes + sizeof(T));
+  }
+}
+
+// true if n equations need at most max_values values - n + 1 and n*(n+1) are never
+// computed when they would overflow
+inline bool fits(size_t n, size_t max_values)
+{
+  return n < max_values && max_values / (n + 1) >= n;
+}
+
+// Skip whitespace and return a pointer to the next character
+inline const char* skip_space(const char* first, const char* last)
+{
+  while (first != last && std::isspace(static_cast<unsigned char>(*first)))
+    ++first;
+  return first;
+}
+} // namespace matrix_io
+
+// Read the number of unknowns n followed by n*(n+1) values using stream extraction
+inline bool read_matrix(std::istream& in, std::valarray<double>& equations, size_t& n)
+{
+  if (!(in >> n) || !matrix_io::fits(n, SIZE_MAX / sizeof(double)))
+    return false;
+  equations.resize(n * (n + 1));
+  for (auto& coeff : equations)
+    if (!(in >> coeff))
+      return false;
+  return true;
+}
+
+// Parse the number of unknowns n followed by n*(n+1) values from characters in memory
+// from_chars() does no locale handling and no allocation, so it is much faster than
+// stream extraction.
+inline bool parse_matrix(const char* first, const char* last,
+                         std::valarray<double>& equations, size_t& n)
+{
+  first = matrix_io::skip_space(first, last);
+  auto result = std::from_chars(first, last, n);
+  if (result.ec != std::errc{})
+    return false;
+  first = result.ptr;
+
+  // Each value takes at least one character and one separator
+  if (!matrix_io::fits(n, static_cast<size_t>(last - first) / 2))
+    return false;
+  equations.resize(n * (n + 1));
+  for (auto& coeff : equations) {
+    first = matrix_io::skip_space(first, last);
+    if (first != last && *first == '+') // from_chars() does not accept a leading +
+      ++first;
+    auto value = std::from_chars(first, last, coeff);
+    if (value.ec != std::errc{})
+      return false;
+    first = value.ptr;
+  }
+  return true;
+}
+
+// Load a text file by mapping it into memory and parsing it with from_chars()
+inline bool load_text_matrix(const std::string& file_name,
+                             std::valarray<double>& equations, size_t& n)
+{
+  Mapped_File file{ file_name };
+  if (!file)
+    return false;
+  file.sequential();
+  return parse_matrix(file.begin(), file.end(), equations, n);
+}
+
+// A binary matrix file mapped into memory
+// The values are mapped copy-on-write, so they can be used in place as working storage
+// by a solver without modifying the file.
+class Binary_Matrix {
+private:
+  Mapped_File file;
+  size_t n{}; // Number of unknowns
+  bool valid{};
+
+public:
+  explicit Binary_Matrix(const std::string& file_name)
+    : file(file_name, Mapped_File::Mode::copy_on_write)
+  {
+    if (!file || file.size() < matrix_io::header_size
+        || std::memcmp(file.data(), matrix_io::magic, sizeof(matrix_io::magic)))
+      return;
+    uint64_t count{};
+    std::memcpy(&count, file.data() + sizeof(matrix_io::magic), sizeof(count));
+    if (!matrix_io::little_endian())
+      matrix_io::reverse_bytes(&count, 1);
+    size_t stored{ (file.size() - matrix_io::header_size) / sizeof(double) };
+    // Checking n against the values stored first means n + 1 cannot overflow
+    if (count == 0 || count >= stored || stored / (count + 1) < count)
+      return; // File is too short for n equations
+    n = static_cast<size_t>(count);
+    if (!matrix_io::little_endian())
+      matrix_io::reverse_bytes(data(), size());
+    valid = true;
+  }
+
+  explicit operator bool() const { return valid; }
+
+  size_t unknowns() const { return n; }
+  size_t size() const { return n * (n + 1); } // Number of values
+  double* data()
+  {
+    return reinterpret_cast<double*>(file.data() + matrix_io::header_size);
+  }
+  const double* data() const
+  {
+    return reinterpret_cast<const double*>(file.data() + matrix_io::header_size);
+  }
+
+  // Copy the values to a valarray
+  std::valarray<double> values() const { return std::valarray<double>(data(), size()); }
+};
+
+// Write the equations in the text format
+inline bool write_text_matrix(const std::string& file_name,
+                              const std::valarray<double>& equations, size_t n)
+{
+  std::ofstream out{ file_name, std::ios_base::out | std::ios_base::trunc };
+  out << n << '\n' << std::setprecision(std::numeric_limits<double>::max_digits10);
+  for (size_t i{}; i < equations.size(); ++i)
+    out << equations[i] << ((i + 1) % (n + 1) ? ' ' : '\n');
+  return static_cast<bool>(out);
+}
+
+// Write the equations in the binary format
+inline bool write_binary_matrix(const std::string& file_name,
+                                const std::valarray<double>& equations, size_t n)
+{
+  std::ofstream out{ file_name,
+                     std::ios_base::out | std::ios_base::trunc | std::ios_base::binary };
+  uint64_t count{ n };
+  std::valarray<double> values{ equations };
+  if (!matrix_io::little_endian()) {
+    matrix_io::reverse_bytes(&count, 1);
+    matrix_io::reverse_bytes(&values[0], values.size());
+  }
+  out.write(matrix_io::magic, sizeof(matrix_io::magic));
+  out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+  if (values.size())
+    out.write(reinterpret_cast<const char*>(&values[0]), values.size() * sizeof(double));
+  return static_cast<bool>(out);
+}
+#endif
@@ -0,0 +1,223 @@
+// Prefetch_Streambuf.h
+// A stream buffer that reads a file ahead of the stream on a background thread
+// There are two buffers of block_size bytes. A reader thread fills one while the stream
+// extracts data from the other, so parsing the data in one block overlaps reading the
+// next block from the file. When the stream reaches the end of its block, the block is
+// handed back to the reader thread and the stream waits for the other block only if it
+// has not been filled yet. Any istream can use the buffer; Prefetch_Istream is an input
+// file stream that owns one. Seeking stops the reader thread, moves the file position,
+// and starts reading ahead again from there.
+
+#ifndef PREFETCH_STREAMBUF_H
+#define PREFETCH_STREAMBUF_H
+
+#include <condition_variable> // For condition_variable
+#include <cstdio>             // For FILE, fopen(), fread(), fseek(), setvbuf()
+#include <istream>            // For istream class
+#include <mutex>              // For mutex, lock_guard, unique_lock
+#include <streambuf>          // For streambuf class
+#include <string>             // For string class
+#include <thread>             // For thread class
+#include <vector>             // For vector container
+
+class Prefetch_Streambuf : public std::streambuf {
+public:
+  static const size_t default_block_size{ 1 << 20 };
+
+private:
+  std::FILE* file{};
+  std::vector<char> blocks[2];
+  size_t sizes[2]{};  // Bytes read into each block - 0 at the end of the file
+  bool filled[2]{};   // true from when a block is filled until the stream releases it
+  size_t current{};   // Block in the get area, or the next block to be used
+  bool in_use{};      // true if the current block is in the get area
+  bool at_end{};      // true when the stream has reached the end of the file
+  off_type offset{};  // File position of the start of the current block
+  bool stopping{};
+  std::mutex mtx;
+  std::condition_variable changed; // Signalled when a block is filled or released
+  std::thread reader;
+
+  // Fill the blocks alternately, each as soon as the stream releases it
+  void read_ahead()
+  {
+    for (size_t i{ current };; i ^= 1) {
+      {
+        std::unique_lock<std::mutex> lock{ mtx };
+        changed.wait(lock, [this, i] { return stopping || !filled[i]; });
+        if (stopping)
+          return;
+      }
+      size_t count{ std::fread(blocks[i].data(), 1, blocks[i].size(), file) };
+      {
+        std::lock_guard<std::mutex> lock{ mtx };
+        sizes[i] = count;
+        filled[i] = true;
+      }
+      changed.notify_all();
+      if (count == 0)
+        return;
+    }
+  }
+
+  void start(off_type position)
+  {
+    current = 0;
+    filled[0] = filled[1] = in_use = at_end = stopping = false;
+    offset = position;
+    setg(nullptr, nullptr, nullptr);
+    reader = std::thread{ &Prefetch_Streambuf::read_ahead, this };
+  }
+
+  void stop()
+  {
+    if (!reader.joinable())
+      return;
+    {
+      std::lock_guard<std::mutex> lock{ mtx };
+      stopping = true;
+    }
+    changed.notify_all();
+    reader.join();
+  }
+
+  // Start reading ahead from position once the reader thread has stopped - if the file
+  // position cannot be moved there, reading starts again from previous so the stream
+  // can still be used, and the result is -1
+  pos_type restart(off_type position, off_type previous)
+  {
+    if (position < 0 || std::fseek(file, static_cast<long>(position), SEEK_SET) != 0) {
+      std::fseek(file, static_cast<long>(previous), SEEK_SET);
+      start(previous);
+      return pos_type(off_type(-1));
+    }
+    start(position);
+    return pos_type(position);
+  }
+
+protected:
+  int_type underflow() override
+  {
+    if (gptr() < egptr())
+      return traits_type::to_int_type(*gptr());
+    if (!file || at_end)
+      return traits_type::eof();
+    std::unique_lock<std::mutex> lock{ mtx };
+    if (in_use) { // Give the block back to the reader thread
+      filled[current] = in_use = false;
+      offset += sizes[current];
+      current ^= 1;
+      changed.notify_all();
+    }
+    changed.wait(lock, [this] { return filled[current]; });
+    in_use = true;
+    if (sizes[current] == 0) {
+      at_end = true;
+      setg(nullptr, nullptr, nullptr);
+      return traits_type::eof();
+    }
+    char* first{ blocks[current].data() };
+    setg(first, first, first + sizes[current]);
+    return traits_type::to_int_type(*gptr());
+  }
+
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir,
+                   std::ios_base::openmode which = std::ios_base::in) override
+  {
+    if (!file || !(which & std::ios_base::in))
+      return pos_type(off_type(-1));
+    off_type position{ offset + (gptr() - eback()) };
+    if (dir == std::ios_base::cur && off == 0)
+      return pos_type(position); // Just reporting the position
+    if (dir == std::ios_base::end) {
+      stop();
+      off_type size{ std::fseek(file, 0, SEEK_END) == 0 ? std::ftell(file) : -1 };
+      return restart(size < 0 ? -1 : size + off, position);
+    }
+    return seekpos(pos_type(dir == std::ios_base::beg ? off : position + off), which);
+  }
+
+  pos_type seekpos(pos_type pos,
+                   std::ios_base::openmode which = std::ios_base::in) override
+  {
+    if (!file || !(which & std::ios_base::in) || off_type(pos) < 0)
+      return pos_type(off_type(-1)); // Rejected without disturbing the reader thread
+    off_type previous{ offset + (gptr() - eback()) };
+    stop();
+    return restart(off_type(pos), previous);
+  }
+
+public:
+  explicit Prefetch_Streambuf(size_t block_size = default_block_size)
+  {
+    for (auto& block : blocks)
+      block.resize(block_size);
+  }
+
+  Prefetch_Streambuf(const std::string& file_name, size_t block_size = default_block_size)
+    : Prefetch_Streambuf(block_size)
+  {
+    open(file_name);
+  }
+
+  ~Prefetch_Streambuf() override { close(); }
+
+  Prefetch_Streambuf(const Prefetch_Streambuf&) = delete;
+  Prefetch_Streambuf& operator=(const Prefetch_Streambuf&) = delete;
+
+  // Open a file for reading - returns false if it cannot be opened
+  bool open(const std::string& file_name)
+  {
+    close();
+    file = std::fopen(file_name.c_str(), "rb");
+    if (!file)
+      return false;
+    std::setvbuf(file, nullptr, _IONBF, 0); // Read straight into the blocks
+    start(0);
+    return true;
+  }
+
+  bool is_open() const { return file != nullptr; }
+
+  void close()
+  {
+    stop();
+    if (file)
+      std::fclose(file);
+    file = nullptr;
+    setg(nullptr, nullptr, nullptr);
+  }
+};
+
+// An input file stream that reads ahead on a background thread
+class Prefetch_Istream : public std::istream {
+private:
+  Prefetch_Streambuf buffer;
+
+public:
+  explicit Prefetch_Istream(size_t block_size = Prefetch_Streambuf::default_block_size)
+    : std::istream(nullptr)
+    , buffer(block_size)
+  {
+    rdbuf(&buffer);
+  }
+
+  explicit Prefetch_Istream(const std::string& file_name,
+                            size_t block_size = Prefetch_Streambuf::default_block_size)
+    : Prefetch_Istream(block_size)
+  {
+    open(file_name);
+  }
+
+  void open(const std::string& file_name)
+  {
+    if (buffer.open(file_name))
+      clear();
+    else
+      setstate(std::ios_base::failbit);
+  }
+
+  bool is_open() const { return buffer.is_open(); }
+  void close() { buffer.close(); }
+};
+#endif
@@ -0,0 +1,162 @@
+// Thread_Pool.h
+// A work-stealing pool of threads
+// Each worker thread has its own queue of tasks. A worker takes tasks from the back of
+// its own queue and, when that is empty, steals from the front of the queues of the
+// other workers, so the work stays balanced when tasks take very different times.
+// Tasks submitted by a worker go to its own queue; others are dealt out in turn.
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm>          // For max()
+#include <atomic>             // For atomic
+#include <condition_variable> // For condition_variable
+#include <cstddef>            // For size_t
+#include <deque>              // For deque container
+#include <functional>         // For function
+#include <memory>             // For unique_ptr
+#include <mutex>              // For mutex, lock_guard, unique_lock
+#include <thread>             // For thread class
+#include <vector>             // For vector container
+
+class Thread_Pool {
+private:
+  using Task = std::function<void()>;
+
+  struct Queue {
+    std::mutex mtx;
+    std::deque<Task> tasks;
+  };
+
+  std::vector<std::unique_ptr<Queue>> queues; // One queue per worker
+  std::vector<std::thread> workers;
+  std::mutex mtx;                     // Guards waiting and finishing
+  std::condition_variable work_ready; // Signalled when a task is queued or on stop
+  std::condition_variable all_done;   // Signalled when no tasks are left
+  std::atomic<size_t> queued{};       // Tasks in the queues
+  size_t pending{};                   // Tasks queued or running
+  size_t next_queue{};                // Queue for the next task from outside the pool
+  bool stopping{};
+
+  // The pool and worker index for the current thread - used to identify workers
+  static Thread_Pool*& current_pool()
+  {
+    thread_local Thread_Pool* pool{};
+    return pool;
+  }
+  static size_t& current_worker()
+  {
+    thread_local size_t id{};
+    return id;
+  }
+
+  // Take the task from the back of a worker's own queue
+  bool pop(size_t id, Task& task)
+  {
+    std::lock_guard<std::mutex> lock{ queues[id]->mtx };
+    if (queues[id]->tasks.empty())
+      return false;
+    task = std::move(queues[id]->tasks.back());
+    queues[id]->tasks.pop_back();
+    return true;
+  }
+
+  // Take the task from the front of another worker's queue
+  bool steal(size_t id, Task& task)
+  {
+    for (size_t i{ 1 }; i < queues.size(); ++i) {
+      auto& victim = *queues[(id + i) % queues.size()];
+      std::lock_guard<std::mutex> lock{ victim.mtx };
+      if (!victim.tasks.empty()) {
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void run(size_t id)
+  {
+    current_pool() = this;
+    current_worker() = id;
+    while (true) {
+      Task task;
+      if (pop(id, task) || steal(id, task)) {
+        --queued;
+        task();
+        std::lock_guard<std::mutex> lock{ mtx };
+        if (--pending == 0)
+          all_done.notify_all();
+        continue;
+      }
+      std::unique_lock<std::mutex> lock{ mtx };
+      work_ready.wait(lock, [this] { return stopping || queued > 0; });
+      if (stopping && queued == 0)
+        return;
+    }
+  }
+
+public:
+  // Create a pool - the default is one thread per processor core
+  explicit Thread_Pool(size_t n_threads = std::thread::hardware_concurrency())
+  {
+    n_threads = std::max(n_threads, size_t{ 1 });
+    for (size_t i{}; i < n_threads; ++i)
+      queues.push_back(std::make_unique<Queue>());
+    for (size_t i{}; i < n_threads; ++i)
+      workers.emplace_back(&Thread_Pool::run, this, i);
+  }
+
+  // Complete all the tasks that have been submitted, then stop the threads
+  ~Thread_Pool()
+  {
+    {
+      std::lock_guard<std::mutex> lock{ mtx };
+      stopping = true;
+    }
+    work_ready.notify_all();
+    for (auto& worker : workers)
+      worker.join();
+  }
+
+  Thread_Pool(const Thread_Pool&) = delete;
+  Thread_Pool& operator=(const Thread_Pool&) = delete;
+
+  size_t size() const { return workers.size(); }
+
+  // Queue a task to be executed by one of the threads
+  void submit(Task task)
+  {
+    size_t id{};
+    {
+      std::lock_guard<std::mutex> lock{ mtx };
+      id = current_pool() == this ? current_worker() : next_queue++ % queues.size();
+      ++pending;
+      ++queued; // Counted first so a worker cannot take the task before it is counted
+    }
+    {
+      std::lock_guard<std::mutex> lock{ queues[id]->mtx };
+      queues[id]->tasks.push_back(std::move(task));
+    }
+    work_ready.notify_one();
+  }
+
+  // Wait until every task that has been submitted is complete
+  // This must not be called by a task.
+  void wait()
+  {
+    std::unique_lock<std::mutex> lock{ mtx };
+    all_done.wait(lock, [this] { return pending == 0; });
+  }
+
+  // Call f(i) for i from 0 to count-1 as separate tasks and wait for them all
+  template <typename F>
+  void parallel_for(size_t count, F f)
+  {
+    for (size_t i{}; i < count; ++i)
+      submit([&f, i] { f(i); });
+    wait();
+  }
+};
+#endif
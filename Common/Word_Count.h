@@ -0,0 +1,192 @@
+// Word_Count.h
+// Counts the frequency of each word in a block of text using any number of threads
+// A word is a sequence of the letters a to z and A to Z. The text is divided into one
+// chunk per thread at whitespace and each thread counts the words in its chunk into its
+// own hash table, so the threads share nothing until the tables are merged at the end.
+// Words are string_view objects that refer to the text, so the text must outlive the
+// counts and counting a word that has been seen before allocates nothing. The tables
+// use open addressing with linear probing in a single array.
+
+#ifndef WORD_COUNT_H
+#define WORD_COUNT_H
+
+#include <algorithm>   // For sort(), nth_element(), min()
+#include <cstdint>     // For uint64_t
+#include <string_view> // For string_view
+#include <utility>     // For pair
+#include <vector>      // For vector container
+
+#include "Thread_Pool.h"
+#include "Word_Histogram.h"
+
+using Word_Frequency = std::pair<std::string_view, size_t>;
+
+// Hash table of word counts
+class Word_Counts {
+private:
+  struct Entry {
+    std::string_view word; // Empty if the slot is unused
+    uint64_t hash{};
+    size_t count{};
+  };
+  std::vector<Entry> slots;
+  size_t used{};  // Number of words in the table
+  size_t total{}; // Number of words counted
+
+  static const uint64_t fnv_basis{ 14695981039346656037ULL };
+  static const uint64_t fnv_prime{ 1099511628211ULL };
+
+  // FNV-1a hash of a word
+  static uint64_t hash(std::string_view word)
+  {
+    uint64_t h{ fnv_basis };
+    for (char ch : word) {
+      h ^= static_cast<unsigned char>(ch);
+      h *= fnv_prime;
+    }
+    return h;
+  }
+
+  // Same as isalpha() in the "C" locale, without the call
+  static bool is_letter(char ch)
+  {
+    return static_cast<unsigned char>((ch | 0x20) - 'a') < 26;
+  }
+
+  // Double the size of the table
+  void grow()
+  {
+    std::vector<Entry> old(slots.size() * 2);
+    old.swap(slots);
+    size_t mask{ slots.size() - 1 };
+    for (const auto& entry : old) {
+      if (entry.word.empty())
+        continue;
+      size_t slot{ entry.hash & mask };
+      while (!slots[slot].word.empty())
+        slot = (slot + 1) & mask;
+      slots[slot] = entry;
+    }
+  }
+
+  void add(std::string_view word, uint64_t h, size_t n)
+  {
+    if (2 * (used + 1) > slots.size()) // No more than half full
+      grow();
+    total += n;
+    size_t mask{ slots.size() - 1 };
+    size_t slot{ h & mask };
+    for (; !slots[slot].word.empty(); slot = (slot + 1) & mask)
+      if (slots[slot].hash == h && slots[slot].word == word) {
+        slots[slot].count += n;
+        return;
+      }
+    slots[slot] = Entry{ word, h, n };
+    ++used;
+  }
+
+public:
+  explicit Word_Counts(size_t capacity = 1024)
+  {
+    size_t size{ 16 };
+    while (size < 2 * capacity)
+      size *= 2;
+    slots.resize(size);
+  }
+
+  // Count n occurrences of a word, which must not be empty
+  void add(std::string_view word, size_t n = 1) { add(word, hash(word), n); }
+
+  // Count the words - sequences of letters - from first to last
+  // The hash of each word is computed as the word is found, so the text is read once.
+  void add_words(const char* first, const char* last)
+  {
+    while (true) {
+      while (first != last && !is_letter(*first))
+        ++first;
+      if (first == last)
+        return;
+      const char* start{ first };
+      uint64_t h{ fnv_basis };
+      for (; first != last && is_letter(*first); ++first) {
+        h ^= static_cast<unsigned char>(*first);
+        h *= fnv_prime;
+      }
+      add(std::string_view(start, static_cast<size_t>(first - start)), h, 1);
+    }
+  }
+
+  // Add the counts from another table
+  Word_Counts& operator+=(const Word_Counts& counts)
+  {
+    for (const auto& entry : counts.slots)
+      if (!entry.word.empty())
+        add(entry.word, entry.hash, entry.count);
+    return *this;
+  }
+
+  size_t size() const { return used; }   // Number of different words
+  size_t words() const { return total; } // Number of words counted
+
+  // The number of times a word was counted
+  size_t count(std::string_view word) const
+  {
+    size_t mask{ slots.size() - 1 };
+    for (size_t slot{ hash(word) & mask }; !slots[slot].word.empty();
+         slot = (slot + 1) & mask)
+      if (slots[slot].word == word)
+        return slots[slot].count;
+    return 0;
+  }
+
+  // The words and their counts in no particular order
+  std::vector<Word_Frequency> frequencies() const
+  {
+    std::vector<Word_Frequency> result;
+    result.reserve(used);
+    for (const auto& entry : slots)
+      if (!entry.word.empty())
+        result.emplace_back(entry.word, entry.count);
+    return result;
+  }
+
+  // The k most frequent words, most frequent first - equal counts are in word order
+  std::vector<Word_Frequency> top(size_t k) const
+  {
+    auto result = frequencies();
+    auto more_frequent = [](const Word_Frequency& a, const Word_Frequency& b) {
+      return a.second > b.second || (a.second == b.second && a.first < b.first);
+    };
+    k = std::min(k, result.size());
+    std::nth_element(std::begin(result), std::begin(result) + k, std::end(result),
+                     more_frequent);
+    result.resize(k);
+    std::sort(std::begin(result), std::end(result), more_frequent);
+    return result;
+  }
+};
+
+// Count the words from first to last using n_threads threads
+inline Word_Counts count_words(const char* first, const char* last, size_t n_threads = 1)
+{
+  auto count = [](const char* begin, const char* end) {
+    Word_Counts counts;
+    counts.add_words(begin, end);
+    return counts;
+  };
+  if (n_threads <= 1)
+    return count(first, last);
+
+  auto bounds = split_at_whitespace(first, last, n_threads);
+  std::vector<Word_Counts> chunk_counts(bounds.size() - 1);
+  {
+    Thread_Pool pool{ n_threads };
+    pool.parallel_for(chunk_counts.size(), [&](size_t i) {
+      chunk_counts[i] = count(bounds[i], bounds[i + 1]);
+    });
+  }
+  for (size_t i{ 1 }; i < chunk_counts.size(); ++i)
+    chunk_counts[0] += chunk_counts[i];
+  return std::move(chunk_counts[0]);
+}
+#endif
@@ -0,0 +1,105 @@
+// Word_Histogram.h
+// Counts the words in a block of text into buckets chosen by a key function
+// The text is divided into chunks at whitespace so no word is split between chunks.
+// Each chunk is counted by a separate task into its own array of counts, and the arrays
+// are merged at the end, so the text is read once whatever the number of buckets and no
+// counter is shared between threads. The key function maps a word to a bucket index;
+// a word with an index outside the buckets is not counted.
+
+#ifndef WORD_HISTOGRAM_H
+#define WORD_HISTOGRAM_H
+
+#include <algorithm>   // For max(), find_if()
+#include <cctype>      // For isspace()
+#include <string_view> // For string_view
+#include <vector>      // For vector container
+
+#include "Thread_Pool.h"
+
+// Bucket for the first letter of a word - a to z are buckets 0 to 25
+struct First_Letter {
+  size_t operator()(std::string_view word) const
+  {
+    return static_cast<unsigned char>(word.front()) - size_t{ 'a' };
+  }
+};
+
+// Bucket for the last letter of a word - a to z are buckets 0 to 25
+struct Last_Letter {
+  size_t operator()(std::string_view word) const
+  {
+    return static_cast<unsigned char>(word.back()) - size_t{ 'a' };
+  }
+};
+
+// Bucket for the length of a word
+struct Word_Length {
+  size_t operator()(std::string_view word) const { return word.length(); }
+};
+
+inline bool is_space(char ch) { return std::isspace(static_cast<unsigned char>(ch)); }
+
+// Divide text into up to n_chunks chunks that start and end at whitespace
+// Returns the chunk boundaries - chunk i is from bounds[i] to bounds[i+1].
+inline std::vector<const char*> split_at_whitespace(const char* first, const char* last,
+                                                    size_t n_chunks)
+{
+  std::vector<const char*> bounds{ first };
+  size_t length(last - first);
+  for (size_t i{ 1 }; i < n_chunks; ++i) {
+    auto split = std::max(bounds.back(), first + i * length / n_chunks);
+    split = std::find_if(split, last, is_space);
+    if (split != bounds.back())
+      bounds.push_back(split);
+  }
+  bounds.push_back(last);
+  return bounds;
+}
+
+// Call f(word) for each word from first to last
+template <typename F>
+void for_each_word(const char* first, const char* last, F f)
+{
+  while (true) {
+    while (first != last && is_space(*first))
+      ++first;
+    if (first == last)
+      return;
+    const char* start{ first };
+    while (first != last && !is_space(*first))
+      ++first;
+    f(std::string_view(start, static_cast<size_t>(first - start)));
+  }
+}
+
+// Count the words from first to last in n_buckets buckets selected by key
+template <typename Key>
+std::vector<size_t> word_histogram(const char* first, const char* last, size_t n_buckets,
+                                   Key key, size_t n_threads = 1)
+{
+  auto count = [n_buckets, &key](const char* begin, const char* end) {
+    std::vector<size_t> counts(n_buckets);
+    for_each_word(begin, end, [&](std::string_view word) {
+      size_t bucket{ key(word) };
+      if (bucket < n_buckets)
+        ++counts[bucket];
+    });
+    return counts;
+  };
+  if (n_threads <= 1)
+    return count(first, last);
+
+  auto bounds = split_at_whitespace(first, last, 4 * n_threads); // Balances the work
+  std::vector<std::vector<size_t>> chunk_counts(bounds.size() - 1);
+  {
+    Thread_Pool pool{ n_threads };
+    pool.parallel_for(chunk_counts.size(), [&](size_t i) {
+      chunk_counts[i] = count(bounds[i], bounds[i + 1]);
+    });
+  }
+  for (size_t i{ 1 }; i < chunk_counts.size(); ++i)
+    for (size_t j{}; j < n_buckets; ++j)
+      chunk_counts[0][j] += chunk_counts[i][j];
+  return chunk_counts[0];
+}
+#endif